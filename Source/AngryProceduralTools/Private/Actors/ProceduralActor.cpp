@@ -8,7 +8,9 @@ AProceduralActor::AProceduralActor(const FObjectInitializer& ObjectInitializer)
 	PreviewLOD(0),
 	MaxLOD(3),
 	CollisionLOD(2),
-	EnableCollision(true)
+	EnableCollision(true),
+	MaxConvexVertices(0),
+	MaxConvexVolumeError(0.0f)
 {
 	USceneComponent* Root = ObjectInitializer.CreateDefaultSubobject<USceneComponent>(this, FName(TEXT("Root")));
 	SetRootComponent(Root);
@@ -41,7 +43,7 @@ bool AProceduralActor::Generate(int32 LOD)
 	const TArray<FGenTriangleMesh> Meshes = GenerateMesh(Base, LOD);
 	if (Meshes.Num() > 0)
 	{
-		UProceduralLibrary::ApplyToMeshes(ProceduralMesh, Meshes, EnableCollision);
+		UProceduralLibrary::ApplyToMeshes(ProceduralMesh, Meshes, EnableCollision, MaxConvexVertices, MaxConvexVolumeError);
 		return true;
 	}
 	return false;
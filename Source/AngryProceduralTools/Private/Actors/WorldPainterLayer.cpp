@@ -104,6 +104,8 @@ void AWorldPainterLayer::PostLoad()
 {
 	Super::PostLoad();
 
+	GenerateTriangulationDone = IsTriangulationIntact() && TriangulationHash == GetTriangulationHash();
+
 #if WITH_EDITOR
 	Bake();
 #endif // WITH_EDITOR
@@ -209,13 +211,33 @@ void AWorldPainterLayer::GenerateTriangulation()
 		}
 	}
 
-	// Create triangulation
-	Triangulation.QHull(Samples, -1);
-	Triangulation.FixTriangles(-1);
+	const bool Reuse = TriangulationSeed == GeneratorSeed && Triangulation.Points.Num() == Samples.Num() && IsTriangulationIntact();
+	TriangulationSeed = GeneratorSeed;
 
+	// Disturbance edits keep the random sequence, vertices only move a little and get repaired locally.
+	// A failed move leaves vertices unconnected, the texture needs all of them
+	if (!Reuse || !Triangulation.MovePoints(Samples))
+	{
+		Triangulation.QHullParallel(MoveTemp(Samples));
+	}
+
+	TriangulationHash = GetTriangulationHash();
 	GenerateTriangulationDone = true;
 }
 
+bool AWorldPainterLayer::IsTriangulationIntact() const
+{
+	return Triangulation.Triangles.ContainsByPredicate([](const FGenTriangle& Triangle) { return !Triangle.IsFreeSlot(); }) && Triangulation.HasValidIndices(Triangulation.Points.Num());
+}
+
+uint32 AWorldPainterLayer::GetTriangulationHash() const
+{
+	uint32 Hash = GetTypeHash(GeneratorSeed);
+	Hash = HashCombine(Hash, GetTypeHash(VertexDisturbance));
+	Hash = HashCombine(Hash, GetTypeHash(VertexSamples));
+	return Hash;
+}
+
 void AWorldPainterLayer::GeneratePoints()
 {
 	Points.Empty();
@@ -278,7 +300,7 @@ void AWorldPainterLayer::GenerateTexture()
 	if (IsValid(RenderMaterial))
 	{
 		TArray<FCanvasUVTri> Tris;
-		Tris.SetNum(TriangleCount);
+		Tris.Reserve(TriangleCount);
 
 		const int32 SliceNum = Bias.Slices.Num();
 		for (int32 Slice = 0; Slice < SliceNum; Slice++)
@@ -293,11 +315,16 @@ void AWorldPainterLayer::GenerateTexture()
 					FDrawToRenderTargetContext Context;
 					UKismetRenderingLibrary::BeginDrawCanvasToRenderTarget(this, TargetTexture, Canvas, Size, Context);
 
+					Tris.Reset();
 					for (int32 TriangleIndex = 0; TriangleIndex < TriangleCount; TriangleIndex++)
 					{
 						const FGenTriangle& Triangle = Triangulation.Triangles[TriangleIndex];
+						if (!Triangle.Enabled)
+						{
+							continue;
+						}
 
-						FCanvasUVTri& Tri = Tris[TriangleIndex];
+						FCanvasUVTri& Tri = Tris.Emplace_GetRef();
 
 						const FVector2D& P0 = Triangulation.Points[Triangle.Verts[0]];
 						const FVector2D& P1 = Triangulation.Points[Triangle.Verts[1]];
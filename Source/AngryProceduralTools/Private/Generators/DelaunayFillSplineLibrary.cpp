@@ -1,12 +1,100 @@
 #include "Generators/DelaunayFillSplineLibrary.h"
 #include "ProceduralMeshComponent.h"
+#include "AngryProceduralTools.h"
 #include "Structures/Matrix3x3.h"
 
+namespace
+{
+	// Inverse of the sample mapping, X runs along both splines and Y across
+	FVector2D ProjectToSamples(USplineComponent* Left, USplineComponent* Right, const FVector& Location)
+	{
+		const float LeftLength = Left->GetSplineLength();
+		const float RightLength = Right->GetSplineLength();
+		const float LeftTime = Left->GetDistanceAlongSplineAtSplineInputKey(Left->FindInputKeyClosestToWorldLocation(Location)) / FMath::Max(LeftLength, SMALL_NUMBER);
+		const float RightTime = Right->GetDistanceAlongSplineAtSplineInputKey(Right->FindInputKeyClosestToWorldLocation(Location)) / FMath::Max(RightLength, SMALL_NUMBER);
+
+		// Blend between both closest points depending on how far across the location is
+		FVector2D Sample = FVector2D((LeftTime + RightTime) / 2, 0.5f);
+		for (int32 Iteration = 0; Iteration < 2; Iteration++)
+		{
+			const FVector From = Left->GetLocationAtDistanceAlongSpline(Sample.X * LeftLength, ESplineCoordinateSpace::World);
+			const FVector To = Right->GetLocationAtDistanceAlongSpline(Sample.X * RightLength, ESplineCoordinateSpace::World);
+			const FVector Delta = To - From;
+			Sample.Y = FMath::Clamp(((Location - From) | Delta) / FMath::Max(Delta.SizeSquared(), SMALL_NUMBER), 0.0f, 1.0f);
+			Sample.X = FMath::Clamp(FMath::Lerp(LeftTime, RightTime, Sample.Y), 0.0f, 1.0f);
+		}
+		return Sample;
+	}
+
+	// Hole square outline in sample space, subdivided so it follows the spline curvature
+	TArray<FVector2D> ComputeHoleLoop(USplineComponent* Left, USplineComponent* Right, const FTransform& Transform, const FTransform& Hole, float Radius, float MaxSize)
+	{
+		const FVector Corners[] = { FVector(-Radius, -Radius, 0.0f), FVector(Radius, -Radius, 0.0f), FVector(Radius, Radius, 0.0f), FVector(-Radius, Radius, 0.0f) };
+
+		TArray<FVector2D> Loop;
+		for (int32 Corner = 0; Corner < 4; Corner++)
+		{
+			const FVector From = Transform.TransformPosition(Hole.TransformPosition(Corners[Corner]));
+			const FVector To = Transform.TransformPosition(Hole.TransformPosition(Corners[(Corner + 1) % 4]));
+			const int32 Cells = FMath::Max(FMath::CeilToInt((To - From).Size() / MaxSize), 1);
+			for (int32 Cell = 0; Cell < Cells; Cell++)
+			{
+				const FVector2D Sample = ProjectToSamples(Left, Right, FMath::Lerp(From, To, ((float)Cell) / Cells));
+				if (Loop.Num() == 0 || !Loop.Last().Equals(Sample, KINDA_SMALL_NUMBER))
+				{
+					Loop.Emplace(Sample);
+				}
+			}
+		}
+
+		// Holes fully outside collapse onto the border
+		double Area = 0.0;
+		for (int32 Index = 0; Index < Loop.Num(); Index++)
+		{
+			Area += Loop[Index] ^ Loop[(Index + 1) % Loop.Num()];
+		}
+		if (Loop.Num() < 3 || FMath::Abs(Area) < KINDA_SMALL_NUMBER)
+		{
+			Loop.Reset();
+		}
+		return Loop;
+	}
+
+	const TCHAR* GetHoleErrorText(ETriangulationHoleError Error)
+	{
+		switch (Error)
+		{
+		case ETriangulationHoleError::Degenerate: return TEXT("its outline has no area");
+		case ETriangulationHoleError::SelfIntersecting: return TEXT("its outline intersects itself");
+		case ETriangulationHoleError::CrossesConstraint: return TEXT("it overlaps another hole");
+		case ETriangulationHoleError::OutsideDomain: return TEXT("its outline leaves the surface");
+		default: return TEXT("unknown reason");
+		}
+	}
+
+	bool IsInsideLoop(const TArray<FVector2D>& Loop, const FVector2D& Point)
+	{
+		bool Inside = false;
+		for (int32 Index = 0, Prev = Loop.Num() - 1; Index < Loop.Num(); Prev = Index++)
+		{
+			const FVector2D& A = Loop[Index];
+			const FVector2D& B = Loop[Prev];
+			if ((A.Y > Point.Y) != (B.Y > Point.Y) && Point.X < A.X + (B.X - A.X) * (Point.Y - A.Y) / (B.Y - A.Y))
+			{
+				Inside = !Inside;
+			}
+		}
+		return Inside;
+	}
+}
+
 FDelaunaySurfaceParams::FDelaunaySurfaceParams()
 :	UpVector(FVector::UpVector),
 	FillerMaxSize(200.0f),
 	FillerHeight(100.0f),
-	Delaunay(true)
+	Delaunay(true),
+	TriangleBudget(0),
+	MinAngle(25.0f)
 {
 }
 
@@ -126,6 +214,12 @@ void UDelaunayFillSplineLibrary::GenerateDelaunay(
 			const int32 Cells = FMath::CeilToInt((To - From).Size() / Surface.FillerMaxSize);
 			for (int32 Cell = 0; Cell <= Cells; Cell++)
 			{
+				// Refinement fills the inside itself
+				if (Surface.TriangleBudget > 0 && Segment > 0 && Segment < Segments && Cell > 0 && Cell < Cells)
+				{
+					continue;
+				}
+
 				const float CellTime = ((float)Cell) / Cells;
 
 				Samples.Emplace(FVector2D(SegmentTime, CellTime));
@@ -149,10 +243,50 @@ void UDelaunayFillSplineLibrary::GenerateDelaunay(
 		}
 		*/
 
+		// Map holes into sample space, samples inside them would only end up as loose vertices
+		TArray<TArray<FVector2D>> HoleLoops;
+		for (const FTransform& Hole : Holes.Transforms)
+		{
+			TArray<FVector2D> HoleLoop = ComputeHoleLoop(Left, Right, Transform, Hole, Holes.Radius, Surface.FillerMaxSize);
+			if (HoleLoop.Num() > 0)
+			{
+				Samples.RemoveAll([&HoleLoop](const FVector2D& Sample) { return IsInsideLoop(HoleLoop, Sample); });
+				HoleLoops.Emplace(MoveTemp(HoleLoop));
+			}
+		}
+
+		// Hole insertion and the final flips share their temporaries, all of them are released with the mark
+		FMemMark Mark(FMemStack::Get());
+		FTriangulationMemStackScratch Scratch;
+
 		// Create triangulation
 		FTriangulation2D Triangulation2D;
-		Triangulation2D.QHull(Samples, -1);
-		Triangulation2D.FixTriangles(-1);
+		Triangulation2D.QHullParallel(Samples);
+
+		// Cut holes along their outline
+		for (const TArray<FVector2D>& HoleLoop : HoleLoops)
+		{
+			TArray<int32> Loop;
+			for (const FVector2D& Point : HoleLoop)
+			{
+				const int32 Vertex = Triangulation2D.AddPoints(Point, Scratch);
+				if (Vertex != INDEX_NONE && (Loop.Num() == 0 || Loop.Last() != Vertex))
+				{
+					Loop.Emplace(Vertex);
+				}
+			}
+
+			if (Loop.Num() > 1 && Loop[0] == Loop.Last())
+			{
+				Loop.Pop();
+			}
+
+			ETriangulationHoleError Error;
+			if (!Triangulation2D.AddHole(Loop, &Error))
+			{
+				UE_LOG(AngryProceduralTools, Warning, TEXT("Failed cutting hole, %s."), GetHoleErrorText(Error));
+			}
+		}
 
 		/*
 		Triangulation2D.SetBorders(FVector2D(0.0f, 0.0f), FVector2D(1.0f, 1.0f));
@@ -167,6 +301,45 @@ void UDelaunayFillSplineLibrary::GenerateDelaunay(
 		}
 		*/
 
+		if (Surface.TriangleBudget > 0)
+		{
+			// Refine in world units so angles and edge lengths are measured on the surface, edges get shorter where the height curves bend
+			const FVector2D Scale = FVector2D::Max(Bounds, FVector2D(SMALL_NUMBER, SMALL_NUMBER));
+			for (FVector2D& Point : Triangulation2D.Points)
+			{
+				Point *= Scale;
+			}
+			Triangulation2D.ResetLocation();
+			Triangulation2D.InvalidateVoronoi();
+
+			const float Height = Surface.FillerHeight * Transform.GetScale3D().GetMax();
+			const auto MaxEdgeLength = [&](const FVector2D& Point) -> double
+			{
+				const FVector2D Sample = Point / Scale;
+				const FVector2D Step = FVector2D(Surface.FillerMaxSize, Surface.FillerMaxSize) / Scale;
+				const float Center = Surface.SampleCurves(Sample.X, Sample.Y);
+				const float BendX = Surface.SampleCurves(Sample.X - Step.X, Sample.Y) + Surface.SampleCurves(Sample.X + Step.X, Sample.Y) - 2.0f * Center;
+				const float BendY = Surface.SampleCurves(Sample.X, Sample.Y - Step.Y) + Surface.SampleCurves(Sample.X, Sample.Y + Step.Y) - 2.0f * Center;
+				const float Bend = FMath::Max(FMath::Abs(BendX), FMath::Abs(BendY)) * Height;
+				return Surface.FillerMaxSize / (1.0f + Bend / Surface.FillerMaxSize);
+			};
+
+			if (!Triangulation2D.Refine(Surface.MinAngle, MaxEdgeLength, Surface.TriangleBudget))
+			{
+				UE_LOG(AngryProceduralTools, Verbose, TEXT("Triangle budget of %d reached before the surface met quality."), Surface.TriangleBudget);
+			}
+
+			for (FVector2D& Point : Triangulation2D.Points)
+			{
+				Point /= Scale;
+			}
+			Triangulation2D.ResetLocation();
+			Triangulation2D.InvalidateVoronoi();
+		}
+
+		// Duplicate samples and failed holes leave vertices no triangle uses, don't carry them into the mesh
+		Triangulation2D.Compact();
+
 		// Create vertices
 		FGenTriangleMesh TriangleMesh;
 
@@ -221,38 +394,13 @@ void UDelaunayFillSplineLibrary::GenerateDelaunay(
 		// Delaunay triangulation to improve the surface
 		if (Surface.Delaunay)
 		{
-			TriangleMesh.Triangulation.FixTriangles(-1);
+			TriangleMesh.Triangulation.FixTriangles(-1, Scratch);
 		}
 		//else if (DrawDebug)
 		//{
 		//	TriangleMesh.Triangulation.DrawTriangles(GetWorld(), Transform);
 		//}
 
-		// Remove triangles around given hole
-		TArray<int32> Changed;
-		for (FGenTriangle& Triangle : TriangleMesh.Triangulation.Triangles)
-		{
-			const FVector A = TriangleMesh.Triangulation.Points[Triangle.Verts[0]];
-			const FVector B = TriangleMesh.Triangulation.Points[Triangle.Verts[1]];
-			const FVector C = TriangleMesh.Triangulation.Points[Triangle.Verts[2]];
-			const FVector Center = (A + B + C) / 3;
-
-			for (const FTransform& Hole : Holes.Transforms)
-			{
-				const float LA = Hole.InverseTransformPosition(A).GetAbsMax();
-				const float LB = Hole.InverseTransformPosition(B).GetAbsMax();
-				const float LC = Hole.InverseTransformPosition(C).GetAbsMax();
-				const float LR = Hole.InverseTransformPosition(Center).GetAbsMax();
-
-				const float HR = Holes.Radius;
-				if (LA < HR || LB < HR || LC < HR || LR < HR)
-				{
-					Triangle.Enabled = false;
-					break;
-				}
-			}
-		}
-
 		// Compute adjacency list from triangulation
 		TArray<TArray<int32>> AdjPoints;
 		TArray<TArray<FVector>> AdjNormals;
@@ -2,6 +2,7 @@
 #include "ProceduralMeshComponent.h"
 #include "AngryProceduralTools.h"
 #include "Utility/TriangleMath.h"
+#include "Utility/TriangleBVH.h"
 #include "Libraries/DiscreteMathLibrary.h"
 
 FFillSurfaceParams::FFillSurfaceParams()
@@ -44,33 +45,11 @@ TArray<float> DivideCurve(USplineComponent* Spline, float Threshold, float Left,
 	return Distances;
 }
 
-bool IntersectsTriangle(const FVector& A, const FVector& B, const FVector& C, const FVector& From, const FVector& To)
+bool IsValidTriangle(const FTransform& Transform, const TArray<FVector>& Locations, const FTriangleBVH& Segments, const TArray<FGenTriangleVertex>& Vertices, int32 Core, int32 Anchor, int32 Probe, int32 Last)
 {
-	const FVector& Normal = (B - A) ^ (C - A);
-
-	if (UTriangleMath::ProjectToSlate(Normal, A, B, From, To))
-	{
-		return true;
-	}
-
-	if (UTriangleMath::ProjectToSlate(Normal, A, C, From, To))
-	{
-		return true;
-	}
-
-	if (UTriangleMath::ProjectToSlate(Normal, B, C, From, To))
-	{
-		return true;
-	}
-
-	return false;
-}
-
-bool IsValidTriangle(const FTransform& Transform, USplineComponent* Spline, const TArray<float>& Distances, const TArray<FGenTriangleVertex>& Vertices, int32 Core, int32 Anchor, int32 Probe, int32 Last)
-{
-	const FVector CoreLocation = Spline->GetLocationAtDistanceAlongSpline(Distances[Core], ESplineCoordinateSpace::World);
-	const FVector AnchorLocation = Spline->GetLocationAtDistanceAlongSpline(Distances[Anchor], ESplineCoordinateSpace::World);
-	const FVector ProbeLocation = Spline->GetLocationAtDistanceAlongSpline(Distances[Probe], ESplineCoordinateSpace::World);
+	const FVector& CoreLocation = Locations[Core];
+	const FVector& AnchorLocation = Locations[Anchor];
+	const FVector& ProbeLocation = Locations[Probe];
 
 	// Check whether triangle goes inwards
 	const FVector AnchorNormal = Transform.TransformVectorNoScale(Vertices[Anchor].Normal);
@@ -78,38 +57,65 @@ bool IsValidTriangle(const FTransform& Transform, USplineComponent* Spline, cons
 	const FVector Plane = (AnchorNormal + CoreNormal) ^ AnchorLocation - CoreLocation;
 	if (((ProbeLocation - CoreLocation) | Plane) > 0.0f)
 	{
-		const int32 Num = Distances.Num();
-
-		int32 Collide = Anchor;
-		const FVector Location = Spline->GetLocationAtDistanceAlongSpline(Distances[Collide], ESplineCoordinateSpace::World);
-		FVector Prev = Location + (Location - CoreLocation).GetClampedToMaxSize(1.0f);
-		while (Collide != Last)
+		const int32 Num = Locations.Num();
+		const int32 Count = (Last - Anchor + Num) % Num;
+
+		// Check whether any future segments intersect with an edge of this triangle, segments leaving the triangle start just outside of it.
+		// Candidates are tested four at a time so the search still stops at the first chunk with a hit
+		const FVector Normal = (AnchorLocation - CoreLocation) ^ (ProbeLocation - CoreLocation);
+		const FVector Edges[3][2] = { { CoreLocation, AnchorLocation }, { CoreLocation, ProbeLocation }, { AnchorLocation, ProbeLocation } };
+		double Coords[6][4];
+		int32 Pending = 0;
+		const auto AnyHits = [&]() -> bool
 		{
-			// Check whether any future segments intersect with this triangle
-			Collide = (Collide + 1) % Num;
-			const FVector Next = Spline->GetLocationAtDistanceAlongSpline(Distances[Collide], ESplineCoordinateSpace::World);
-
-			if (Collide != Probe)
+			const FPointsSoA Starts = { TArrayView<const double>(Coords[0], Pending), TArrayView<const double>(Coords[1], Pending), TArrayView<const double>(Coords[2], Pending) };
+			const FPointsSoA Ends = { TArrayView<const double>(Coords[3], Pending), TArrayView<const double>(Coords[4], Pending), TArrayView<const double>(Coords[5], Pending) };
+			bool Hits[4];
+			const TArrayView<bool> Out(Hits, Pending);
+			for (int32 Edge = 0; Edge < 3; Edge++)
 			{
-				if (IntersectsTriangle(CoreLocation, AnchorLocation, ProbeLocation, Prev, Next))
+				UTriangleMath::ProjectToSlate(Normal, Edges[Edge][0], Edges[Edge][1], Starts, Ends, Out);
+				if (Out.Contains(true))
 				{
-					return false;
+					return true;
 				}
-				Prev = Next;
 			}
-			else
+			Pending = 0;
+			return false;
+		};
+
+		const bool Intersects = Segments.AnyInPrism(CoreLocation, AnchorLocation, ProbeLocation, 1.0, [&](int32 Segment)
+		{
+			const int32 Next = (Segment + 1) % Num;
+			if ((Segment - Anchor + Num) % Num >= Count || Next == Probe)
+			{
+				return false;
+			}
+
+			FVector From = Locations[Segment];
+			if (Segment == Anchor || Segment == Probe)
 			{
-				Prev = Next + (ProbeLocation - CoreLocation).GetClampedToMaxSize(1.0f);
+				From += (From - CoreLocation).GetClampedToMaxSize(1.0f);
 			}
-		}
-		return true;
+
+			const FVector& To = Locations[Next];
+			for (int32 Axis = 0; Axis < 3; Axis++)
+			{
+				Coords[Axis][Pending] = From[Axis];
+				Coords[Axis + 3][Pending] = To[Axis];
+			}
+			return ++Pending == 4 && AnyHits();
+		});
+
+		// Fewer than four candidates left over go through the scalar tail of the batched test
+		return !Intersects && (Pending == 0 || !AnyHits());
 	}
 	return false;
 }
 
-bool BuildConvex(const FTransform& Transform, USplineComponent* Spline, const TArray<float>& Distances, const TArray<FGenTriangleVertex>& Vertices, int32 From, int32 To, FTriangulation3D& Triangulation, TArray<FGenConvex>& Convexes)
+bool BuildConvex(const FTransform& Transform, const TArray<FVector>& Locations, const FTriangleBVH& Segments, const TArray<FGenTriangleVertex>& Vertices, int32 From, int32 To, FTriangulation3D& Triangulation, TArray<FGenConvex>& Convexes)
 {
-	const int32 Num = Distances.Num();
+	const int32 Num = Locations.Num();
 	int32 Prev = INDEX_NONE;
 
 	const int32 Core = From;
@@ -122,7 +128,7 @@ bool BuildConvex(const FTransform& Transform, USplineComponent* Spline, const TA
 		for (;;)
 		{
 			Probe = (Probe + 1) % Num;
-			if (IsValidTriangle(Transform, Spline, Distances, Vertices, Core, Anchor, Probe, To))
+			if (IsValidTriangle(Transform, Locations, Segments, Vertices, Core, Anchor, Probe, To))
 			{
 				break;
 			}
@@ -137,7 +143,7 @@ bool BuildConvex(const FTransform& Transform, USplineComponent* Spline, const TA
 		const int32 Old = Triangulation.Triangles.Num();
 
 		// Build concave part we potentially skipped over
-		if (!BuildConvex(Transform, Spline, Distances, Vertices, Anchor, Probe, Triangulation, Convexes))
+		if (!BuildConvex(Transform, Locations, Segments, Vertices, Anchor, Probe, Triangulation, Convexes))
 		{
 			return false;
 		}
@@ -242,9 +248,20 @@ void UFillDelaunayLibrary::GenerateFill(
 			*/
 		}
 
+		// Sample the spline once, candidate triangles only test the segments close to them
+		TArray<FVector> Locations;
+		Locations.Reserve(Num);
+		for (const float Distance : Distances)
+		{
+			Locations.Emplace(Spline->GetLocationAtDistanceAlongSpline(Distance, ESplineCoordinateSpace::World));
+		}
+
+		FTriangleBVH Segments;
+		Segments.Build(Locations, true);
+
 		// Triangulate space
 		TArray<FGenConvex> Convexes;
-		if (!BuildConvex(Transform, Spline, Distances, TriangleMesh.Vertices, 0, Num - 1, TriangleMesh.Triangulation, Convexes))
+		if (!BuildConvex(Transform, Locations, Segments, TriangleMesh.Vertices, 0, Num - 1, TriangleMesh.Triangulation, Convexes))
 		{
 			UE_LOG(AngryProceduralTools, Error, TEXT("Failed building convex mesh."));
 		}
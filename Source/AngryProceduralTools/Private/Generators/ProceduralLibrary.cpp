@@ -1,6 +1,8 @@
 #include "Generators/ProceduralLibrary.h"
 #include "ProceduralMeshComponent.h"
 #include "Components/InstancedStaticMeshComponent.h"
+#include "Utility/ConvexHull.h"
+#include "AngryProceduralTools.h"
 
 FProceduralMaterialParams::FProceduralMaterialParams()
 :	NormalisedUV(false),
@@ -162,9 +164,13 @@ FGenTriangleMesh UProceduralLibrary::CombineMesheSection(const FGenTriangleMesh&
 		Triangle.Verts[0] += VertexNum;
 		Triangle.Verts[1] += VertexNum;
 		Triangle.Verts[2] += VertexNum;
-		Triangle.Adjs[0] += TriangleNum;
-		Triangle.Adjs[1] += TriangleNum;
-		Triangle.Adjs[2] += TriangleNum;
+		for (int32& Adj : Triangle.Adjs)
+		{
+			if (Adj != INDEX_NONE)
+			{
+				Adj += TriangleNum;
+			}
+		}
 	}
 	Output.Triangulation.Points.Append(Other.Triangulation.Points);
 	Output.Triangulation.Triangles.Append(Triangles);
@@ -254,14 +260,16 @@ void UProceduralLibrary::PopulateInstancedMesh(UInstancedStaticMeshComponent* Co
 }
 
 
-void UProceduralLibrary::ApplyToMeshes(UProceduralMeshComponent* ProceduralMesh, const TArray<FGenTriangleMesh>& Meshes, bool EnableCollision)
+void UProceduralLibrary::ApplyToMeshes(UProceduralMeshComponent* ProceduralMesh, const TArray<FGenTriangleMesh>& Meshes, bool EnableCollision, int32 MaxConvexVertices, float MaxConvexVolumeError)
 {
 	if (IsValid(ProceduralMesh))
 	{
-		ProceduralMesh->ClearCollisionConvexMeshes();
 		ProceduralMesh->EmptyOverrideMaterials();
 		ProceduralMesh->ClearAllMeshSections();
 
+		// Collision is cooked once for all sections and hulls at the end, sections set directly don't update it
+		TArray<TArray<FVector>> Convexes;
+
 		const int32 MeshNum = Meshes.Num();
 		for (int32 Index = 0; Index < MeshNum; Index++)
 		{
@@ -272,37 +280,72 @@ void UProceduralLibrary::ApplyToMeshes(UProceduralMeshComponent* ProceduralMesh,
 			{
 				if (Convex.Points.Num() >= 4)
 				{
-					ProceduralMesh->AddCollisionConvexMesh(Convex.Points);
+					// Cooking and collision cost grow with hull vertices, raw point lists repeat a lot of them. Flat clouds are passed on as they are
+					FConvexHull Hull;
+					if (Hull.Build(Convex.Points, MaxConvexVertices, MaxConvexVolumeError))
+					{
+						if (Hull.VolumeError > MaxConvexVolumeError)
+						{
+							UE_LOG(AngryProceduralTools, Verbose, TEXT("Convex hull of %s reached %d vertices at %.1f%% volume error, above the %.1f%% allowed."),
+								*ProceduralMesh->GetPathName(), Hull.Points.Num(), Hull.VolumeError * 100.0, MaxConvexVolumeError * 100.0f);
+						}
+						Convexes.Emplace(MoveTemp(Hull.Points));
+					}
+					else
+					{
+						Convexes.Emplace(Convex.Points);
+					}
 					HasConvex = true;
 				}
 			}
 
-			// Convert into mesh
-			TArray<int32> Faces;
+			// Fill the component's own section in place, vertices only disabled triangles use are dropped and indices remapped in the same pass
+			ProceduralMesh->SetProcMeshSection(Index, FProcMeshSection());
+			FProcMeshSection& Section = *ProceduralMesh->GetProcMeshSection(Index);
+
+			const TArray<FVector>& Points = Mesh.Triangulation.Points;
+			TArray<int32> Remap;
+			Remap.Init(INDEX_NONE, Points.Num());
+
+			Section.ProcVertexBuffer.Reserve(Points.Num());
+			Section.ProcIndexBuffer.Reserve(Mesh.Triangulation.Triangles.Num() * 3);
 			for (const FGenTriangle& Triangle : Mesh.Triangulation.Triangles)
 			{
-				if (Triangle.Enabled)
+				if (!Triangle.Enabled)
 				{
-					Faces.Append({ Triangle.Verts[0], Triangle.Verts[1], Triangle.Verts[2] });
+					continue;
 				}
-			}
 
-			TArray<FVector> Normals;
-			TArray<FVector2D> UVs;
-			TArray<FColor> Colors;
-			TArray<FProcMeshTangent> Tangents;
-			for (const FGenTriangleVertex& Vertex : Mesh.Vertices)
-			{
-				Normals.Emplace(Vertex.Normal);
-				UVs.Emplace(Vertex.UV);
-				Colors.Emplace(Vertex.Color);
-				Tangents.Emplace(FProcMeshTangent(Vertex.Tangent, false));
+				for (int32 Vert : Triangle.Verts)
+				{
+					int32& Mapped = Remap[Vert];
+					if (Mapped == INDEX_NONE)
+					{
+						Mapped = Section.ProcVertexBuffer.Num();
+						FProcMeshVertex& Vertex = Section.ProcVertexBuffer.AddDefaulted_GetRef();
+						Vertex.Position = Points[Vert];
+						if (Mesh.Vertices.IsValidIndex(Vert))
+						{
+							const FGenTriangleVertex& Source = Mesh.Vertices[Vert];
+							Vertex.Normal = Source.Normal;
+							Vertex.Tangent = FProcMeshTangent(Source.Tangent, false);
+							Vertex.Color = Source.Color;
+							Vertex.UV0 = Source.UV;
+						}
+						Section.SectionLocalBox += Vertex.Position;
+					}
+					Section.ProcIndexBuffer.Emplace(Mapped);
+				}
 			}
 
-			ProceduralMesh->CreateMeshSection(Index, Mesh.Triangulation.Points, Faces, Normals, UVs, Colors, Tangents, EnableCollision && (ProceduralMesh->bUseComplexAsSimpleCollision || HasConvex));
+			// Handing the section back assigns it to itself, which only updates bounds and render state
+			Section.bEnableCollision = EnableCollision && (ProceduralMesh->bUseComplexAsSimpleCollision || HasConvex);
+			ProceduralMesh->SetProcMeshSection(Index, Section);
 
 			ProceduralMesh->SetMaterial(Index, Mesh.Material);
 		}
+
+		ProceduralMesh->SetCollisionConvexMeshes(Convexes);
 	}
 }
 
@@ -120,6 +120,7 @@ void Generate(
 		}
 	}
 
+	TriangleMesh.Triangulation.BuildAdjacency();
 	TriangleMesh.Material = Material.Material.Material;
 	Meshes.Emplace(TriangleMesh);
 }
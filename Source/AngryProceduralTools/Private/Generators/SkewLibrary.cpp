@@ -1,5 +1,6 @@
 #include "Generators/SkewLibrary.h"
 #include "ProceduralMeshComponent.h"
+#include "AngryProceduralTools.h"
 #include "PhysicsEngine/BodySetup.h"
 
 FSkewParams::FSkewParams()
@@ -154,6 +155,12 @@ void USkewLibrary::GenerateSkew(
 					Triangle.Verts[1] = Triangles[Index * 3 + 1];
 					Triangle.Verts[2] = Triangles[Index * 3 + 2];
 				}
+
+				const int32 NonManifold = Mesh.Triangulation.BuildAdjacency();
+				if (NonManifold > 0)
+				{
+					UE_LOG(AngryProceduralTools, Verbose, TEXT("Section %d of %s has %d non-manifold edges"), SectionIndex, *StaticMesh->GetName(), NonManifold);
+				}
 			}
 
 			//// SIMPLE COLLISION
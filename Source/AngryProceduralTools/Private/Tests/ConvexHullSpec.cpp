@@ -0,0 +1,160 @@
+#include "Utility/ConvexHull.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace
+{
+	enum class EHullCloud : uint8
+	{
+		Uniform,
+		Sphere,
+		Grid
+	};
+
+	TArray<FVector> MakeHullCloud(EHullCloud Cloud, int32 Seed)
+	{
+		FRandomStream Random(Seed);
+		TArray<FVector> Points;
+		switch (Cloud)
+		{
+		case EHullCloud::Uniform:
+			while (Points.Num() < 500)
+			{
+				Points.Emplace(FVector(Random.FRandRange(-50.0f, 50.0f), Random.FRandRange(-20.0f, 20.0f), Random.FRandRange(-5.0f, 5.0f)));
+			}
+			break;
+
+		case EHullCloud::Sphere:
+			while (Points.Num() < 300)
+			{
+				Points.Emplace(Random.GetUnitVector() * 100.0);
+			}
+			break;
+
+		default:
+			// Many coplanar and collinear points on every face
+			for (int32 Index = 0; Index < 216; Index++)
+			{
+				Points.Emplace(FVector(Index % 6, (Index / 6) % 6, Index / 36) * (1.0 + Random.RandHelper(3)));
+			}
+			break;
+		}
+		return Points;
+	}
+}
+
+BEGIN_DEFINE_SPEC(FConvexHullSpec, "AngryProceduralTools.ConvexHull", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+	/** Counts hulls that aren't closed, aren't convex, leave cloud points outside or whose faces disagree with the tracked volume */
+	int32 CheckHull(const FConvexHull& Hull, TArrayView<const FVector> Cloud)
+	{
+		int32 Failures = 0;
+
+		// Every edge is used once in each direction and V - E + F = 2
+		TMap<uint64, int32> Edges;
+		for (const FIntVector& Face : Hull.Faces)
+		{
+			for (int32 Vert = 0; Vert < 3; Vert++)
+			{
+				Edges.FindOrAdd(((uint64)Face[Vert] << 32) | (uint64)Face[(Vert + 1) % 3])++;
+			}
+		}
+		for (const TPair<uint64, int32>& Edge : Edges)
+		{
+			Failures += Edge.Value != 1 || Edges.FindRef((Edge.Key << 32) | (Edge.Key >> 32)) != 1;
+		}
+		Failures += Hull.Points.Num() - Edges.Num() / 2 + Hull.Faces.Num() != 2;
+
+		// Faces are counter-clockwise from outside, the hull vertices and full hulls the whole cloud lie behind all of them
+		const double Tolerance = FBox(Cloud.GetData(), Cloud.Num()).GetExtent().GetMax() * 1e-6;
+		const bool Full = Hull.VolumeError == 0.0;
+		double Volume = 0.0;
+		for (const FIntVector& Face : Hull.Faces)
+		{
+			const FVector& A = Hull.Points[Face.X];
+			const FVector& B = Hull.Points[Face.Y];
+			const FVector& C = Hull.Points[Face.Z];
+			const FVector Normal = ((B - A) ^ (C - A)).GetSafeNormal();
+			Volume += (A | (B ^ C)) / 6.0;
+
+			for (const FVector& Point : Full ? Cloud : TArrayView<const FVector>(Hull.Points))
+			{
+				Failures += ((Point - A) | Normal) > Tolerance;
+			}
+		}
+		Failures += !FMath::IsNearlyEqual(Volume, Hull.Volume, Hull.Volume * 1e-6);
+		return Failures;
+	}
+
+END_DEFINE_SPEC(FConvexHullSpec)
+
+void FConvexHullSpec::Define()
+{
+	It("should build closed convex hulls containing the cloud", [this]()
+	{
+		int32 Failures = 0;
+		for (int32 Seed = 0; Seed < 300; Seed++)
+		{
+			const TArray<FVector> Cloud = MakeHullCloud((EHullCloud)(Seed % 3), Seed);
+			FConvexHull Hull;
+			if (!Hull.Build(Cloud))
+			{
+				Failures++;
+				continue;
+			}
+			Failures += CheckHull(Hull, Cloud);
+			Failures += Hull.VolumeError != 0.0;
+		}
+		TestEqual(TEXT("Failures"), Failures, 0);
+	});
+
+	It("should stop at the vertex budget or the volume error, whichever comes first", [this]()
+	{
+		int32 Failures = 0;
+		int32 BudgetStops = 0;
+		int32 ErrorStops = 0;
+		for (int32 Seed = 0; Seed < 300; Seed++)
+		{
+			const TArray<FVector> Cloud = MakeHullCloud((EHullCloud)(Seed % 3), Seed);
+			FConvexHull Hull;
+			if (!Hull.Build(Cloud, 12, 0.05))
+			{
+				Failures++;
+				continue;
+			}
+			Failures += CheckHull(Hull, Cloud);
+
+			// Every added point adds one vertex, so a hull the budget stopped is exactly at the budget
+			const bool WithinError = Hull.VolumeError <= 0.05;
+			Failures += Hull.Points.Num() > 12 || (!WithinError && Hull.Points.Num() != 12);
+			BudgetStops += !WithinError;
+			ErrorStops += WithinError && Hull.Points.Num() < 12;
+		}
+		TestEqual(TEXT("Failures"), Failures, 0);
+		TestTrue(TEXT("Both limits reached"), BudgetStops > 0 && ErrorStops > 0);
+	});
+
+	It("should keep the volume error without a vertex budget", [this]()
+	{
+		int32 Failures = 0;
+		for (int32 Seed = 0; Seed < 30; Seed++)
+		{
+			const TArray<FVector> Cloud = MakeHullCloud(EHullCloud::Sphere, Seed);
+			FConvexHull Hull;
+			Failures += !Hull.Build(Cloud, 0, 0.1) || Hull.VolumeError > 0.1 || CheckHull(Hull, Cloud) > 0;
+		}
+		TestEqual(TEXT("Failures"), Failures, 0);
+	});
+
+	It("should fail on flat clouds and fewer than four points", [this]()
+	{
+		FConvexHull Hull;
+		const TArray<FVector> Flat = { FVector(0.0, 0.0, 0.0), FVector(1.0, 0.0, 0.0), FVector(0.0, 1.0, 0.0), FVector(1.0, 1.0, 0.0), FVector(0.5, 0.2, 0.0) };
+		TestFalse(TEXT("Flat"), Hull.Build(Flat));
+		TestEqual(TEXT("Faces"), Hull.Faces.Num(), 0);
+		TestFalse(TEXT("Three points"), Hull.Build(TArrayView<const FVector>(Flat.GetData(), 3)));
+	});
+}
+
+#endif
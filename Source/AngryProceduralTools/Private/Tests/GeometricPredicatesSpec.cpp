@@ -0,0 +1,225 @@
+#include "Utility/GeometricPredicates.h"
+#include "Utility/TriangleMath.h"
+#include "Utility/Triangulation.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace
+{
+	int8 GetReferenceSign(const TArray<FVector2D>& Points, const FIntVector4& Quad)
+	{
+		const double Sign = FGeometricPredicates::InCircle(Points[Quad.X], Points[Quad.Y], Points[Quad.Z], Points[Quad.W]) * FGeometricPredicates::Orient2D(Points[Quad.X], Points[Quad.Y], Points[Quad.Z]);
+		return (Sign > 0.0) ? 1 : ((Sign < 0.0) ? -1 : 0);
+	}
+}
+
+BEGIN_DEFINE_SPEC(FGeometricPredicatesSpec, "AngryProceduralTools.GeometricPredicates", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+	TArray<FVector2D> Points;
+	TArray<FIntVector4> Quads;
+	TArray<int8> Signs;
+
+	/** Classifies all quads and counts lanes that disagree with the exact predicates and lanes left to them */
+	void Classify(int32& OutMismatches, int32& OutUndecided)
+	{
+		Signs.SetNumUninitialized(Quads.Num());
+		FGeometricPredicates::ClassifyInCircles(Points, Quads, Signs);
+
+		OutMismatches = 0;
+		OutUndecided = 0;
+		for (int32 Index = 0; Index < Quads.Num(); Index++)
+		{
+			OutUndecided += Signs[Index] == 0;
+			OutMismatches += Signs[Index] != 0 && Signs[Index] != GetReferenceSign(Points, Quads[Index]);
+		}
+	}
+
+END_DEFINE_SPEC(FGeometricPredicatesSpec)
+
+void FGeometricPredicatesSpec::Define()
+{
+	BeforeEach([this]()
+	{
+		Points.Reset();
+		Quads.Reset();
+	});
+
+	Describe("ClassifyInCircles", [this]()
+	{
+		It("should agree with InCircle on random quads in either winding", [this]()
+		{
+			FRandomStream Random(11);
+			for (int32 Index = 0; Index < 40000; Index++)
+			{
+				Points.Emplace(FVector2D(Random.FRandRange(-100.0f, 100.0f), Random.FRandRange(-100.0f, 100.0f)));
+			}
+			for (int32 Index = 0; Index + 3 < Points.Num(); Index += 4)
+			{
+				Quads.Emplace(FIntVector4(Index, Index + 1, Index + 2, Index + 3));
+			}
+
+			int32 Mismatches, Undecided;
+			Classify(Mismatches, Undecided);
+			TestEqual(TEXT("Mismatches"), Mismatches, 0);
+			TestTrue(TEXT("Decided most"), Undecided < Quads.Num() / 100);
+		});
+
+		It("should leave cocircular quads to the exact predicates", [this]()
+		{
+			// Cells of an integer grid, far from the origin too, and points on a circle with a radius of five
+			const FVector2D Offsets[] = { FVector2D(0.0, 0.0), FVector2D(1e7, -3e7) };
+			for (const FVector2D& Offset : Offsets)
+			{
+				const int32 Base = Points.Num();
+				Points.Append({ Offset, Offset + FVector2D(1.0, 0.0), Offset + FVector2D(1.0, 1.0), Offset + FVector2D(0.0, 1.0) });
+				Quads.Emplace(FIntVector4(Base, Base + 1, Base + 2, Base + 3));
+				Quads.Emplace(FIntVector4(Base + 3, Base + 2, Base + 1, Base));
+			}
+
+			const int32 Base = Points.Num();
+			Points.Append({ FVector2D(5.0, 0.0), FVector2D(3.0, 4.0), FVector2D(-4.0, 3.0), FVector2D(0.0, -5.0), FVector2D(-3.0, -4.0) });
+			Quads.Emplace(FIntVector4(Base, Base + 1, Base + 2, Base + 3));
+			Quads.Emplace(FIntVector4(Base + 4, Base + 2, Base + 1, Base));
+
+			int32 Mismatches, Undecided;
+			Classify(Mismatches, Undecided);
+			TestEqual(TEXT("Mismatches"), Mismatches, 0);
+			TestEqual(TEXT("Undecided"), Undecided, Quads.Num());
+		});
+
+		It("should leave collinear triangles and repeated points to the exact predicates", [this]()
+		{
+			Points.Append({ FVector2D(0.0, 0.0), FVector2D(1.0, 1.0), FVector2D(2.0, 2.0), FVector2D(0.0, 1.0) });
+			Quads.Emplace(FIntVector4(0, 1, 2, 3));
+			Quads.Emplace(FIntVector4(0, 0, 1, 3));
+			Quads.Emplace(FIntVector4(1, 2, 3, 1));
+
+			int32 Mismatches, Undecided;
+			Classify(Mismatches, Undecided);
+			TestEqual(TEXT("Mismatches"), Mismatches, 0);
+			TestEqual(TEXT("Undecided"), Undecided, Quads.Num());
+		});
+
+		It("should only decide nearly cocircular quads when the filter is certain", [this]()
+		{
+			// Fourth points a few ulps off the circumcircle, rounding decides most of these
+			FRandomStream Random(12);
+			for (int32 Index = 0; Index < 1001; Index++)
+			{
+				const FVector2D Center(Random.FRandRange(-1e4f, 1e4f), Random.FRandRange(-1e4f, 1e4f));
+				const double Radius = Random.FRandRange(1.0f, 100.0f);
+				const double Angles[4] = { 0.3, 2.1, 4.0, Random.FRandRange(0.0f, 6.28f) };
+
+				const int32 Base = Points.Num();
+				for (double Angle : Angles)
+				{
+					Points.Emplace(Center + FVector2D(FMath::Cos(Angle), FMath::Sin(Angle)) * Radius);
+				}
+				Quads.Emplace(FIntVector4(Base, Base + 1, Base + 2, Base + 3));
+			}
+
+			int32 Mismatches, Undecided;
+			Classify(Mismatches, Undecided);
+			TestEqual(TEXT("Mismatches"), Mismatches, 0);
+			TestTrue(TEXT("Fell back"), Undecided > 0);
+		});
+	});
+
+	Describe("ComputeCircumcenters", [this]()
+	{
+		It("should match the scalar reference including degenerate lanes and free slots", [this]()
+		{
+			FRandomStream Random(13);
+			TArray<FVector2D> Points2D;
+			TArray<FVector> Points3D;
+			for (int32 Index = 0; Index < 3000; Index++)
+			{
+				const FVector Point(Random.FRandRange(-100.0f, 100.0f), Random.FRandRange(-100.0f, 100.0f), Random.FRandRange(-100.0f, 100.0f));
+				Points2D.Emplace(FVector2D(Point));
+				Points3D.Emplace(Point);
+			}
+
+			// Collinear triangles, repeated vertices and free slots go through the fallback, a count that isn't a multiple of four covers the tail
+			Points2D.Append({ FVector2D(0.0, 0.0), FVector2D(1.0, 1.0), FVector2D(2.0, 2.0) });
+			Points3D.Append({ FVector(0.0, 0.0, 0.0), FVector(1.0, 1.0, 1.0), FVector(2.0, 2.0, 2.0) });
+
+			TArray<FGenTriangle> Triangles;
+			for (int32 Index = 0; Index + 2 < 3000; Index += 3)
+			{
+				Triangles.Emplace(FGenTriangle(Index, Index + 1, Index + 2));
+				if (Index % 300 == 0)
+				{
+					Triangles.Emplace(FGenTriangle(3000, 3001, 3002));
+					Triangles.Emplace(FGenTriangle(Index, Index, Index + 1));
+					Triangles.Emplace(FGenTriangle());
+				}
+			}
+			Triangles.Emplace(FGenTriangle(3000, 3002, 3001));
+
+			TArray<FVector2D> Centers2D, ScalarCenters2D;
+			TArray<FVector> Centers3D, ScalarCenters3D;
+			TArray<double> Radii2D, ScalarRadii2D, Radii3D, ScalarRadii3D;
+			for (TArray<double>* Radii : { &Radii2D, &ScalarRadii2D, &Radii3D, &ScalarRadii3D })
+			{
+				Radii->SetNumUninitialized(Triangles.Num());
+			}
+			Centers2D.SetNumUninitialized(Triangles.Num());
+			ScalarCenters2D.SetNumUninitialized(Triangles.Num());
+			Centers3D.SetNumUninitialized(Triangles.Num());
+			ScalarCenters3D.SetNumUninitialized(Triangles.Num());
+
+			UTriangleMath::ComputeCircumcenters2D(Points2D, Triangles, Centers2D, Radii2D);
+			UTriangleMath::ComputeCircumcenters2DScalar(Points2D, Triangles, ScalarCenters2D, ScalarRadii2D);
+			UTriangleMath::ComputeCircumcenters(Points3D, Triangles, Centers3D, Radii3D);
+			UTriangleMath::ComputeCircumcentersScalar(Points3D, Triangles, ScalarCenters3D, ScalarRadii3D);
+
+			int32 Mismatches = 0;
+			for (int32 Index = 0; Index < Triangles.Num(); Index++)
+			{
+				const double Tolerance = 1e-9 * FMath::Max(1.0, ScalarRadii2D[Index]);
+				Mismatches += !Centers2D[Index].Equals(ScalarCenters2D[Index], FMath::Sqrt(Tolerance)) || !FMath::IsNearlyEqual(Radii2D[Index], ScalarRadii2D[Index], Tolerance);
+				const double Tolerance3D = 1e-9 * FMath::Max(1.0, ScalarRadii3D[Index]);
+				Mismatches += !Centers3D[Index].Equals(ScalarCenters3D[Index], FMath::Sqrt(Tolerance3D)) || !FMath::IsNearlyEqual(Radii3D[Index], ScalarRadii3D[Index], Tolerance3D);
+			}
+			TestEqual(TEXT("Mismatches"), Mismatches, 0);
+			TestTrue(TEXT("Free slot"), Centers2D[3].IsZero() && Radii2D[3] == 0.0 && Centers3D[3].IsZero() && Radii3D[3] == 0.0);
+		});
+
+		It("should agree with InCircle away from the circle", [this]()
+		{
+			FRandomStream Random(14);
+			for (int32 Index = 0; Index < 4000; Index++)
+			{
+				Points.Emplace(FVector2D(Random.FRandRange(-100.0f, 100.0f), Random.FRandRange(-100.0f, 100.0f)));
+			}
+
+			TArray<FGenTriangle> Triangles;
+			for (int32 Index = 0; Index + 3 < Points.Num(); Index += 4)
+			{
+				Triangles.Emplace(FGenTriangle(Index, Index + 1, Index + 2));
+			}
+
+			TArray<FVector2D> Centers;
+			TArray<double> Radii;
+			Centers.SetNumUninitialized(Triangles.Num());
+			Radii.SetNumUninitialized(Triangles.Num());
+			UTriangleMath::ComputeCircumcenters2D(Points, Triangles, Centers, Radii);
+
+			int32 Mismatches = 0;
+			for (int32 Index = 0; Index < Triangles.Num(); Index++)
+			{
+				const FGenTriangle& Triangle = Triangles[Index];
+				const FVector2D& D = Points[Triangle.Verts[0] + 3];
+				const double Distance = (Centers[Index] - D).SizeSquared();
+				if (FMath::IsNearlyEqual(Distance, Radii[Index], Radii[Index] * 1e-6)) continue;
+
+				const int32 Quad = GetReferenceSign(Points, FIntVector4(Triangle.Verts[0], Triangle.Verts[1], Triangle.Verts[2], Triangle.Verts[0] + 3));
+				Mismatches += (Distance < Radii[Index]) != (Quad > 0);
+			}
+			TestEqual(TEXT("Mismatches"), Mismatches, 0);
+		});
+	});
+}
+
+#endif
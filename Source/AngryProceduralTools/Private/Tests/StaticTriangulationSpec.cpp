@@ -0,0 +1,132 @@
+#include "Utility/StaticTriangulation.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace
+{
+	// Used triangles rotated to start at their smallest vertex and sorted, equal for the same triangulation in any slot order
+	TArray<FIntVector> GetSortedTriangles(const FTriangulation2D& Triangulation)
+	{
+		TArray<FIntVector> Sorted;
+		for (const FGenTriangle& Triangle : Triangulation.Triangles)
+		{
+			if (Triangle.IsFreeSlot()) continue;
+
+			const int32 First = (Triangle.Verts[0] < Triangle.Verts[1] && Triangle.Verts[0] < Triangle.Verts[2]) ? 0 : (Triangle.Verts[1] < Triangle.Verts[2] ? 1 : 2);
+			Sorted.Emplace(FIntVector(Triangle.Verts[First], Triangle.Verts[(First + 1) % 3], Triangle.Verts[(First + 2) % 3]));
+		}
+		Sorted.Sort([](const FIntVector& A, const FIntVector& B)
+		{
+			return A.X != B.X ? A.X < B.X : (A.Y != B.Y ? A.Y < B.Y : A.Z < B.Z);
+		});
+		return Sorted;
+	}
+}
+
+BEGIN_DEFINE_SPEC(FStaticTriangulationSpec, "AngryProceduralTools.StaticTriangulation", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+	TStaticTriangulation<32> Small;
+	FTriangulation2D Copy;
+
+END_DEFINE_SPEC(FStaticTriangulationSpec)
+
+void FStaticTriangulationSpec::Define()
+{
+	BeforeEach([this]()
+	{
+		Copy.Reset();
+	});
+
+	It("should match QHull on small random shapes", [this]()
+	{
+		FRandomStream Random(21);
+		int32 Failures = 0;
+		int32 Mismatches = 0;
+		for (int32 Shape = 0; Shape < 300; Shape++)
+		{
+			TArray<FVector2D> Cloud;
+			const int32 Num = 3 + Random.RandHelper(30);
+			while (Cloud.Num() < Num)
+			{
+				Cloud.Emplace(FVector2D(Random.FRand(), Random.FRand()));
+			}
+
+			if (!Small.Triangulate(Cloud))
+			{
+				Failures++;
+				continue;
+			}
+			Small.CopyTo(Copy);
+			Failures += !Copy.Validate(true);
+
+			FTriangulation2D General;
+			General.QHull(Cloud, -1, true);
+			Mismatches += GetSortedTriangles(Copy) != GetSortedTriangles(General);
+		}
+		TestEqual(TEXT("Failures"), Failures, 0);
+		TestEqual(TEXT("Mismatches"), Mismatches, 0);
+	});
+
+	It("should triangulate cocircular grids with duplicates left unused", [this]()
+	{
+		// Sorted insertion makes every new point extend the hull along a collinear border
+		TArray<FVector2D> Cloud;
+		for (int32 Index = 0; Index < 30; Index++)
+		{
+			Cloud.Emplace(FVector2D(Index % 5, Index / 5));
+		}
+		Cloud[29] = Cloud[7];
+
+		TestTrue(TEXT("Triangulated"), Small.Triangulate(Cloud));
+		Small.CopyTo(Copy);
+		TestTrue(TEXT("Valid"), Copy.Validate(true));
+
+		bool Used = false;
+		for (const FGenTriangle& Triangle : Copy.Triangles)
+		{
+			Used |= Triangle.HasVertex(29);
+		}
+		TestFalse(TEXT("Duplicate used"), Used);
+	});
+
+	It("should fail on collinear and too many points", [this]()
+	{
+		const TArray<FVector2D> Line = { FVector2D(0.0, 0.0), FVector2D(1.0, 1.0), FVector2D(3.0, 3.0), FVector2D(2.0, 2.0) };
+		TestFalse(TEXT("Collinear"), Small.Triangulate(Line));
+		TestEqual(TEXT("Triangles"), Small.Triangles.Num(), 0);
+
+		TArray<FVector2D> Many;
+		for (int32 Index = 0; Index < 33; Index++)
+		{
+			Many.Emplace(FVector2D(Index, Index * Index));
+		}
+		TestFalse(TEXT("Too many"), Small.Triangulate(Many));
+	});
+
+	It("should replace constraints and free slots of the target", [this]()
+	{
+		TArray<FVector2D> Grid;
+		for (int32 Index = 0; Index < 100; Index++)
+		{
+			Grid.Emplace(FVector2D(Index % 10, Index / 10));
+		}
+		Copy.QHull(Grid, -1, true);
+		Copy.AddConstraint(0, 99);
+		TestTrue(TEXT("Removed"), Copy.RemovePoint(57));
+
+		const TArray<FVector2D> Square = { FVector2D(0.0, 0.0), FVector2D(1.0, 0.0), FVector2D(1.0, 1.0), FVector2D(0.0, 1.0), FVector2D(0.5, 0.3) };
+		Small.Triangulate(Square);
+		Small.CopyTo(Copy);
+
+		TestEqual(TEXT("Constraints"), Copy.Constraints.Num(), 0);
+		TestEqual(TEXT("Triangles"), Copy.Triangles.Num(), Small.Triangles.Num());
+		TestTrue(TEXT("Valid"), Copy.Validate(true));
+
+		// A free slot left behind would be handed out and overwrite a triangle of the copy
+		TestEqual(TEXT("Inserted"), Copy.AddPoints(FVector2D(0.6, 0.6)), 5);
+		TestTrue(TEXT("Valid after inserting"), Copy.Validate(true));
+	});
+}
+
+#endif
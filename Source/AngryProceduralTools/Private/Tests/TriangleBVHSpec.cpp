@@ -0,0 +1,117 @@
+#include "Utility/TriangleBVH.h"
+#include "Utility/Triangulation.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+BEGIN_DEFINE_SPEC(FTriangleBVHSpec, "AngryProceduralTools.TriangleBVH", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+	/** Unit cube, every face split along a diagonal */
+	FTriangulation3D Cube;
+	FTriangleBVH CubeTree;
+
+END_DEFINE_SPEC(FTriangleBVHSpec)
+
+void FTriangleBVHSpec::Define()
+{
+	BeforeEach([this]()
+	{
+		Cube.Points.Reset();
+		Cube.Triangles.Reset();
+		for (int32 Corner = 0; Corner < 8; Corner++)
+		{
+			Cube.Points.Emplace(FVector(Corner & 1, (Corner >> 1) & 1, (Corner >> 2) & 1));
+		}
+
+		const int32 Faces[6][4] = { { 0, 2, 3, 1 }, { 4, 5, 7, 6 }, { 0, 1, 5, 4 }, { 2, 6, 7, 3 }, { 0, 4, 6, 2 }, { 1, 3, 7, 5 } };
+		for (const int32* Face : Faces)
+		{
+			Cube.Triangles.Emplace(FGenTriangle(Face[0], Face[1], Face[2]));
+			Cube.Triangles.Emplace(FGenTriangle(Face[0], Face[2], Face[3]));
+		}
+		CubeTree.Build(Cube);
+	});
+
+	Describe("IsInside", [this]()
+	{
+		It("should classify points clearly inside and outside", [this]()
+		{
+			TestTrue(TEXT("Center"), CubeTree.IsInside(FVector(0.5, 0.5, 0.5)));
+			TestFalse(TEXT("Beside"), CubeTree.IsInside(FVector(1.5, 0.5, 0.5)));
+			TestFalse(TEXT("Outside bounds"), CubeTree.IsInside(FVector(-3.0, 0.5, 0.5)));
+		});
+
+		It("should count a ray through a shared edge or vertex once", [this]()
+		{
+			// Points placed so the first ray direction runs exactly through a face diagonal or a corner
+			const FVector Ray(0.5773, 0.5774, 0.5775);
+			const FVector Targets[] = { FVector(1.0, 0.3, 0.3), FVector(0.4, 1.0, 0.4), FVector(1.0, 1.0, 1.0) };
+			for (const FVector& Target : Targets)
+			{
+				const FVector Point = Target - Ray * 0.25;
+				TestTrue(FString::Printf(TEXT("Inside towards %s"), *Target.ToString()), CubeTree.IsInside(Point));
+			}
+		});
+	});
+
+	Describe("FindNearest", [this]()
+	{
+		It("should match a linear scan", [this]()
+		{
+			FRandomStream Random(3);
+			FTriangulation3D Soup;
+			for (int32 Index = 0; Index < 3000; Index++)
+			{
+				Soup.Points.Emplace(FVector(Random.FRand(), Random.FRand(), Random.FRand()) * 100.0);
+			}
+			for (int32 Index = 0; Index < 1000; Index++)
+			{
+				Soup.Triangles.Emplace(FGenTriangle(Index * 3, Index * 3 + 1, Index * 3 + 2));
+			}
+
+			FTriangleBVH Tree;
+			Tree.Build(Soup);
+
+			int32 Mismatches = 0;
+			for (int32 Query = 0; Query < 500; Query++)
+			{
+				const FVector Point(Random.FRandRange(-10.0f, 110.0f), Random.FRandRange(-10.0f, 110.0f), Random.FRandRange(-10.0f, 110.0f));
+				FVector Closest;
+				Tree.FindNearest(Point, Closest);
+
+				double Best = TNumericLimits<double>::Max();
+				for (int32 Index = 0; Index < 1000; Index++)
+				{
+					const FVector Candidate = FMath::ClosestPointOnTriangleToPoint(Point, Soup.Points[Index * 3], Soup.Points[Index * 3 + 1], Soup.Points[Index * 3 + 2]);
+					Best = FMath::Min(Best, (Candidate - Point).SizeSquared());
+				}
+				Mismatches += FMath::Abs((Closest - Point).SizeSquared() - Best) > 1e-9 ? 1 : 0;
+			}
+			TestEqual(TEXT("Mismatches"), Mismatches, 0);
+		});
+
+		It("should find the nearest polyline segment", [this]()
+		{
+			const TArray<FVector> Polyline = { FVector(0.0, 0.0, 0.0), FVector(10.0, 0.0, 0.0), FVector(10.0, 10.0, 0.0), FVector(0.0, 10.0, 0.0) };
+			FTriangleBVH Tree;
+			Tree.Build(Polyline, true);
+
+			FVector Closest;
+			TestEqual(TEXT("Closing segment"), Tree.FindNearest(FVector(-1.0, 5.0, 0.0), Closest), 3);
+			TestTrue(TEXT("Closest point"), Closest.Equals(FVector(0.0, 5.0, 0.0)));
+		});
+	});
+
+	Describe("IntersectSegment", [this]()
+	{
+		It("should return the first hit along the segment", [this]()
+		{
+			double Time;
+			const int32 Hit = CubeTree.IntersectSegment(FVector(-1.0, 0.3, 0.6), FVector(2.0, 0.3, 0.6), Time);
+			TestTrue(TEXT("Hit"), Hit != INDEX_NONE);
+			TestTrue(TEXT("Time at the near face"), FMath::IsNearlyEqual(Time, 1.0 / 3.0, 1e-9));
+		});
+	});
+}
+
+#endif
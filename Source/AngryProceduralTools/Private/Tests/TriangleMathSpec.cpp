@@ -0,0 +1,140 @@
+#include "Utility/TriangleMath.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace
+{
+	// Whether a segment ends or crosses within float precision of the slate border, where the batched and scalar projections may disagree
+	bool IsNearSlateBorder(const FVector& Normal, const FVector& A, const FVector& B, const FVector& S, const FVector& T)
+	{
+		const FVector AB = B - A;
+		const FVector Plane = (AB ^ Normal).GetSafeNormal();
+		const double TSProject = (T - S) | Plane;
+		if (FMath::Abs(FMath::Square(TSProject) - SMALL_NUMBER) < 1e-4)
+		{
+			return true;
+		}
+
+		const double Ratio = ((A - S) | Plane) / TSProject;
+		const double Distance = AB.Size();
+		const double Project = ((S + (T - S) * Ratio) - A) | (AB / Distance);
+		return FMath::Abs(Ratio) < 1e-4 || FMath::Abs(Ratio - 1.0) < 1e-4 || FMath::Abs(Project) < 1e-4 || FMath::Abs(Project - Distance) < 1e-4;
+	}
+}
+
+BEGIN_DEFINE_SPEC(FTriangleMathSpec, "AngryProceduralTools.TriangleMath", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+	/** One random array per coordinate, starts then ends */
+	TArray<double> Coords[6];
+
+END_DEFINE_SPEC(FTriangleMathSpec)
+
+void FTriangleMathSpec::Define()
+{
+	BeforeEach([this]()
+	{
+		// A count that isn't a multiple of four covers the scalar tail
+		FRandomStream Random(15);
+		for (TArray<double>& Coord : Coords)
+		{
+			Coord.Reset();
+			while (Coord.Num() < 100003)
+			{
+				Coord.Emplace(Random.FRandRange(-1.0f, 1.0f));
+			}
+		}
+	});
+
+	Describe("ProjectToBox", [this]()
+	{
+		It("should match the scalar version including vectors on an axis", [this]()
+		{
+			// Lanes on either axis and at the origin take the axis cases
+			for (int32 Index = 0; Index < 300; Index += 3)
+			{
+				Coords[0][Index] = 0.0;
+				Coords[1][Index + 1] = 0.0;
+				Coords[0][Index + 2] = 0.0;
+				Coords[1][Index + 2] = 0.0;
+			}
+
+			const int32 Num = Coords[0].Num();
+			TArray<float> Lengths, ScalarLengths;
+			Lengths.SetNumUninitialized(Num);
+			ScalarLengths.SetNumUninitialized(Num);
+			UTriangleMath::ProjectToBox(Coords[0], Coords[1], Lengths);
+			UTriangleMath::ProjectToBoxScalar(Coords[0], Coords[1], ScalarLengths);
+
+			int32 Mismatches = 0;
+			for (int32 Index = 0; Index < Num; Index++)
+			{
+				Mismatches += !FMath::IsNearlyEqual(Lengths[Index], ScalarLengths[Index], FMath::Max(ScalarLengths[Index] * 1e-5f, 1e-6f));
+			}
+			TestEqual(TEXT("Mismatches"), Mismatches, 0);
+		});
+	});
+
+	Describe("ProjectToSlate", [this]()
+	{
+		It("should match the scalar version away from the slate border", [this]()
+		{
+			const int32 Num = Coords[0].Num();
+			const FPointsSoA Starts = { Coords[0], Coords[1], Coords[2] };
+			const FPointsSoA Ends = { Coords[3], Coords[4], Coords[5] };
+			TArray<bool> Hits, ScalarHits;
+			Hits.SetNumUninitialized(Num);
+			ScalarHits.SetNumUninitialized(Num);
+
+			FRandomStream Random(16);
+			int32 Mismatches = 0;
+			int32 Crossing = 0;
+			for (int32 Slate = 0; Slate < 16; Slate++)
+			{
+				const FVector A = Random.GetUnitVector();
+				const FVector B = Random.GetUnitVector();
+				const FVector Normal = (B - A) ^ Random.GetUnitVector();
+				UTriangleMath::ProjectToSlate(Normal, A, B, Starts, Ends, Hits);
+				UTriangleMath::ProjectToSlateScalar(Normal, A, B, Starts, Ends, ScalarHits);
+
+				for (int32 Index = 0; Index < Num; Index++)
+				{
+					Crossing += ScalarHits[Index];
+					if (Hits[Index] != ScalarHits[Index])
+					{
+						const FVector S(Coords[0][Index], Coords[1][Index], Coords[2][Index]);
+						const FVector T(Coords[3][Index], Coords[4][Index], Coords[5][Index]);
+						Mismatches += !IsNearSlateBorder(Normal, A, B, S, T);
+					}
+				}
+			}
+			TestEqual(TEXT("Mismatches"), Mismatches, 0);
+			TestTrue(TEXT("Crossing any"), Crossing > 0);
+		});
+
+		It("should hit segments through the slate and miss parallel and passing ones", [this]()
+		{
+			// Slate along the X axis in the XY plane, segments cross the line Y = 0
+			const FVector Normal(0.0, 0.0, 1.0);
+			const FVector A(0.0, 0.0, 0.0);
+			const FVector B(4.0, 0.0, 0.0);
+			const double StartsX[] = { 1.0, 1.0, 5.0, 3.0, 2.0 };
+			const double StartsY[] = { -1.0, 1.0, -1.0, 0.5, 1.0 };
+			const double EndsX[] = { 2.0, 3.0, 6.0, 3.0, 2.0 };
+			const double EndsY[] = { 1.0, 1.0, 1.0, 2.0, 0.0 };
+			const double Zeros[] = { 0.0, 0.0, 0.0, 0.0, 0.0 };
+			const FPointsSoA Starts = { StartsX, StartsY, Zeros };
+			const FPointsSoA Ends = { EndsX, EndsY, Zeros };
+
+			bool Hits[5];
+			UTriangleMath::ProjectToSlate(Normal, A, B, Starts, Ends, Hits);
+			TestTrue(TEXT("Crossing"), Hits[0]);
+			TestFalse(TEXT("Parallel"), Hits[1]);
+			TestFalse(TEXT("Beside the slate"), Hits[2]);
+			TestFalse(TEXT("Ending before the slate"), Hits[3]);
+			TestTrue(TEXT("Ending on the slate"), Hits[4]);
+		});
+	});
+}
+
+#endif
@@ -0,0 +1,415 @@
+#include "Utility/Triangulation.h"
+#include "Misc/AutomationTest.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace
+{
+	TArray<FVector2D> MakeUniformCloud(int32 Num, int32 Seed)
+	{
+		FRandomStream Random(Seed);
+		TArray<FVector2D> Points;
+		while (Points.Num() < Num)
+		{
+			Points.Emplace(FVector2D(Random.FRand(), Random.FRand()));
+		}
+		return Points;
+	}
+
+	// Every cell is cocircular and the border is collinear, the worst case for tie breaking
+	TArray<FVector2D> MakeGridCloud(int32 Width, int32 Height)
+	{
+		TArray<FVector2D> Points;
+		for (int32 Index = 0; Index < Width * Height; Index++)
+		{
+			Points.Emplace(FVector2D(Index % Width, Index / Width));
+		}
+		return Points;
+	}
+
+	// Dense gaussian blobs with a few points in between
+	TArray<FVector2D> MakeClusteredCloud(int32 Num, int32 Seed)
+	{
+		FRandomStream Random(Seed);
+		TArray<FVector2D> Centers;
+		for (int32 Index = 0; Index < 8; Index++)
+		{
+			Centers.Emplace(FVector2D(Random.FRand(), Random.FRand()));
+		}
+
+		TArray<FVector2D> Points;
+		while (Points.Num() < Num)
+		{
+			const FVector2D& Center = Centers[Random.RandHelper(Centers.Num())];
+			const double Radius = 0.01 * FMath::Sqrt(-2.0 * FMath::Loge(FMath::Max(Random.FRand(), SMALL_NUMBER)));
+			const double Angle = Random.FRand() * 2.0 * PI;
+			Points.Emplace(Center + FVector2D(FMath::Cos(Angle), FMath::Sin(Angle)) * Radius);
+		}
+		return Points;
+	}
+
+	// Used triangles rotated to start at their smallest vertex and sorted, equal for the same triangulation in any slot order
+	TArray<FIntVector> GetCanonicalTriangles(const FTriangulation2D& Triangulation)
+	{
+		TArray<FIntVector> Canonical;
+		for (const FGenTriangle& Triangle : Triangulation.Triangles)
+		{
+			if (Triangle.IsFreeSlot() || !Triangle.Enabled) continue;
+
+			const int32 First = (Triangle.Verts[0] < Triangle.Verts[1] && Triangle.Verts[0] < Triangle.Verts[2]) ? 0 : (Triangle.Verts[1] < Triangle.Verts[2] ? 1 : 2);
+			Canonical.Emplace(FIntVector(Triangle.Verts[First], Triangle.Verts[(First + 1) % 3], Triangle.Verts[(First + 2) % 3]));
+		}
+		Canonical.Sort([](const FIntVector& A, const FIntVector& B)
+		{
+			return A.X != B.X ? A.X < B.X : (A.Y != B.Y ? A.Y < B.Y : A.Z < B.Z);
+		});
+		return Canonical;
+	}
+
+	bool UsesAllPoints(const FTriangulation2D& Triangulation)
+	{
+		TBitArray<> Used(false, Triangulation.Points.Num());
+		for (const FGenTriangle& Triangle : Triangulation.Triangles)
+		{
+			if (Triangle.IsFreeSlot()) continue;
+
+			for (int32 Vert : Triangle.Verts)
+			{
+				Used[Vert] = true;
+			}
+		}
+		return Used.Find(false) == INDEX_NONE;
+	}
+
+	// Smallest angle in degrees over the enabled triangles
+	double GetMinAngle(const FTriangulation2D& Triangulation)
+	{
+		double MinAngle = 180.0;
+		for (const FGenTriangle& Triangle : Triangulation.Triangles)
+		{
+			if (Triangle.IsFreeSlot() || !Triangle.Enabled) continue;
+
+			for (int32 Vert = 0; Vert < 3; Vert++)
+			{
+				const FVector2D& Corner = Triangulation.Points[Triangle.Verts[Vert]];
+				const FVector2D A = (Triangulation.Points[Triangle.Verts[(Vert + 1) % 3]] - Corner).GetSafeNormal();
+				const FVector2D B = (Triangulation.Points[Triangle.Verts[(Vert + 2) % 3]] - Corner).GetSafeNormal();
+				MinAngle = FMath::Min(MinAngle, FMath::RadiansToDegrees(FMath::Acos(FMath::Clamp(A | B, -1.0, 1.0))));
+			}
+		}
+		return MinAngle;
+	}
+
+	int32 GetUsedTriangles(const FTriangulation2D& Triangulation)
+	{
+		return Triangulation.Triangles.FilterByPredicate([](const FGenTriangle& Triangle) { return !Triangle.IsFreeSlot(); }).Num();
+	}
+}
+
+BEGIN_DEFINE_SPEC(FTriangulationSpec, "AngryProceduralTools.Triangulation", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+	FTriangulation2D Triangulation;
+
+END_DEFINE_SPEC(FTriangulationSpec)
+
+void FTriangulationSpec::Define()
+{
+	BeforeEach([this]()
+	{
+		Triangulation = FTriangulation2D();
+	});
+
+	Describe("QHull", [this]()
+	{
+		It("should be Delaunay and use every point", [this]()
+		{
+			const TArray<FVector2D> Clouds[] = { MakeUniformCloud(3000, 1), MakeClusteredCloud(3000, 2), MakeGridCloud(50, 60) };
+			for (const TArray<FVector2D>& Cloud : Clouds)
+			{
+				Triangulation.QHull(Cloud, -1, true);
+				TestTrue(FString::Printf(TEXT("Valid on %d points"), Cloud.Num()), Triangulation.Validate(true));
+				TestTrue(FString::Printf(TEXT("Connected on %d points"), Cloud.Num()), UsesAllPoints(Triangulation));
+			}
+		});
+
+		It("should yield the same triangles when built in parallel stripes", [this]()
+		{
+			const TArray<FVector2D> Clouds[] = { MakeUniformCloud(5000, 3), MakeGridCloud(70, 70) };
+			for (const TArray<FVector2D>& Cloud : Clouds)
+			{
+				Triangulation.QHull(Cloud, -1, true);
+				const TArray<FIntVector> Expected = GetCanonicalTriangles(Triangulation);
+
+				Triangulation.QHullParallel(Cloud, 512);
+				TestTrue(FString::Printf(TEXT("Valid on %d points"), Cloud.Num()), Triangulation.Validate(true));
+				TestTrue(FString::Printf(TEXT("Same triangles on %d points"), Cloud.Num()), GetCanonicalTriangles(Triangulation) == Expected);
+			}
+		});
+	});
+
+	Describe("FixTriangles", [this]()
+	{
+		It("should legalize an unlegalized hull", [this]()
+		{
+			Triangulation.QHull(MakeUniformCloud(3000, 4), -1, false);
+			TestTrue(TEXT("Valid before"), Triangulation.Validate(false));
+
+			Triangulation.Counters.Reset();
+			Triangulation.FixTriangles(-1);
+			TestTrue(TEXT("Delaunay after"), Triangulation.Validate(true));
+			TestTrue(TEXT("Flipped"), Triangulation.Counters.Flips > 0);
+		});
+	});
+
+	Describe("AddPoints", [this]()
+	{
+		It("should stay Delaunay when inserting a batch", [this]()
+		{
+			// Points outside the hull are skipped, corners make sure the batch lands inside
+			const TArray<FVector2D> Cloud = MakeClusteredCloud(4000, 5);
+			TArray<FVector2D> Start(Cloud.GetData(), 2000);
+			Start.Append({ FVector2D(-1.0, -1.0), FVector2D(2.0, -1.0), FVector2D(2.0, 2.0), FVector2D(-1.0, 2.0) });
+			Triangulation.QHull(MoveTemp(Start), -1, true);
+			Triangulation.AddPoints(TArrayView<const FVector2D>(Cloud.GetData() + 2000, 2000));
+
+			TestTrue(TEXT("Valid"), Triangulation.Validate(true));
+			TestEqual(TEXT("Points"), Triangulation.Points.Num(), 4004);
+			TestTrue(TEXT("Connected"), UsesAllPoints(Triangulation));
+		});
+	});
+
+	Describe("FindTriangle", [this]()
+	{
+		It("should find the triangle containing a centroid", [this]()
+		{
+			Triangulation.QHull(MakeUniformCloud(3000, 6), -1, true);
+
+			FRandomStream Random(6);
+			int32 Misses = 0;
+			for (int32 Query = 0; Query < 1000; Query++)
+			{
+				const int32 Index = Random.RandHelper(Triangulation.Triangles.Num());
+				const FGenTriangle& Triangle = Triangulation.Triangles[Index];
+				const FVector2D Centroid = (Triangulation.Points[Triangle.Verts[0]] + Triangulation.Points[Triangle.Verts[1]] + Triangulation.Points[Triangle.Verts[2]]) / 3.0;
+				Misses += Triangulation.FindTriangle(Centroid) != Index;
+			}
+			TestEqual(TEXT("Misses"), Misses, 0);
+			TestEqual(TEXT("Outside"), Triangulation.FindTriangle(FVector2D(2.0, 2.0)), (int32)INDEX_NONE);
+		});
+	});
+
+	Describe("RemovePoint", [this]()
+	{
+		It("should stay Delaunay and compact to the remaining points", [this]()
+		{
+			Triangulation.QHull(MakeGridCloud(30, 30), -1, true);
+
+			FRandomStream Random(7);
+			int32 Removed = 0;
+			for (int32 Attempt = 0; Attempt < 200; Attempt++)
+			{
+				Removed += Triangulation.RemovePoint(Random.RandHelper(Triangulation.Points.Num()));
+			}
+			TestTrue(TEXT("Removed any"), Removed > 0);
+			TestTrue(TEXT("Valid"), Triangulation.Validate(true));
+
+			Triangulation.Compact();
+			TestTrue(TEXT("Valid after compacting"), Triangulation.Validate(true));
+			TestEqual(TEXT("Points"), Triangulation.Points.Num(), 900 - Removed);
+		});
+	});
+
+	Describe("MovePoints", [this]()
+	{
+		It("should stay Delaunay and move every vertex to its target", [this]()
+		{
+			const TArray<FVector2D> Cloud = MakeUniformCloud(2000, 8);
+			Triangulation.QHull(Cloud, -1, true);
+
+			FRandomStream Random(8);
+			TArray<FVector2D> Targets;
+			for (const FVector2D& Point : Cloud)
+			{
+				Targets.Emplace(Point + FVector2D(Random.FRandRange(-0.02f, 0.02f), Random.FRandRange(-0.02f, 0.02f)));
+			}
+
+			TestTrue(TEXT("Moved"), Triangulation.MovePoints(Targets));
+			TestTrue(TEXT("Valid"), Triangulation.Validate(true));
+			TestTrue(TEXT("At targets"), Triangulation.Points == Targets);
+		});
+
+		It("should keep removed vertices out when targets leave the hull", [this]()
+		{
+			const TArray<FVector2D> Cloud = MakeUniformCloud(500, 17);
+			Triangulation.QHull(Cloud, -1, true);
+			TestTrue(TEXT("Removed"), Triangulation.RemovePoint(251));
+
+			// Scattered far beyond the hull, the hull is extended or rebuilt around them
+			FRandomStream Random(17);
+			TArray<FVector2D> Targets = Cloud;
+			for (int32 Index = 0; Index < Targets.Num(); Index += 5)
+			{
+				Targets[Index] = FVector2D(Random.FRandRange(-3.0f, 4.0f), Random.FRandRange(-3.0f, 4.0f));
+			}
+
+			Triangulation.MovePoints(Targets);
+			TestTrue(TEXT("Valid"), Triangulation.Validate(true));
+
+			bool Used = false;
+			for (const FGenTriangle& Triangle : Triangulation.Triangles)
+			{
+				Used |= !Triangle.IsFreeSlot() && Triangle.HasVertex(251);
+			}
+			TestFalse(TEXT("Removed vertex used"), Used);
+		});
+	});
+
+	Describe("Constraints", [this]()
+	{
+		BeforeEach([this]()
+		{
+			Triangulation.QHull(MakeGridCloud(10, 10), -1, true);
+		});
+
+		It("should keep constrained edges across a cocircular grid", [this]()
+		{
+			TestTrue(TEXT("Added"), Triangulation.AddConstraint(0, 99));
+			TestTrue(TEXT("Constrained"), Triangulation.IsConstrained(44, 55));
+			TestTrue(TEXT("Valid"), Triangulation.Validate(true));
+		});
+
+		It("should remove the triangles inside a hole", [this]()
+		{
+			const TArray<int32> Loop = { 22, 27, 77, 72 };
+			TestTrue(TEXT("Cut"), Triangulation.AddHole(Loop));
+			TestTrue(TEXT("Valid"), Triangulation.Validate(true));
+
+			int32 Inside = 0;
+			for (const FGenTriangle& Triangle : Triangulation.Triangles)
+			{
+				if (Triangle.IsFreeSlot() || !Triangle.Enabled) continue;
+
+				const FVector2D Centroid = (Triangulation.Points[Triangle.Verts[0]] + Triangulation.Points[Triangle.Verts[1]] + Triangulation.Points[Triangle.Verts[2]]) / 3.0;
+				Inside += Centroid.X > 2.0 && Centroid.X < 7.0 && Centroid.Y > 2.0 && Centroid.Y < 7.0;
+			}
+			TestEqual(TEXT("Triangles inside"), Inside, 0);
+		});
+
+		It("should reject a self-intersecting hole and keep the constraints", [this]()
+		{
+			const TArray<int32> Loop = { 22, 77, 27, 72 };
+			ETriangulationHoleError Error = ETriangulationHoleError::None;
+			TestFalse(TEXT("Cut"), Triangulation.AddHole(Loop, &Error));
+			TestTrue(TEXT("Self-intersecting"), Error == ETriangulationHoleError::SelfIntersecting);
+			TestEqual(TEXT("Constraints"), Triangulation.Constraints.Num(), 0);
+			TestTrue(TEXT("Valid"), Triangulation.Validate(true));
+		});
+	});
+
+	Describe("Refine", [this]()
+	{
+		It("should reach the minimum angle and stay Delaunay", [this]()
+		{
+			int32 Failures = 0;
+			for (int32 Seed = 0; Seed < 30; Seed++)
+			{
+				const TArray<FVector2D> Cloud = (Seed % 3 == 0) ? MakeGridCloud(5 + Seed / 3, 12) : ((Seed % 3 == 1) ? MakeUniformCloud(300, Seed) : MakeClusteredCloud(300, Seed));
+				Triangulation.QHull(Cloud, -1, true);
+				Failures += !Triangulation.Refine(25.0, [](const FVector2D&) { return 0.0; }, 200000);
+				Failures += !Triangulation.Validate(true) || GetMinAngle(Triangulation) < 25.0 - KINDA_SMALL_NUMBER;
+			}
+			TestEqual(TEXT("Failures"), Failures, 0);
+		});
+
+		It("should split constraints instead of crossing them and keep holes empty", [this]()
+		{
+			Triangulation.QHull(MakeGridCloud(10, 10), -1, true);
+			TestTrue(TEXT("Constrained"), Triangulation.AddConstraint(0, 99));
+			TestTrue(TEXT("Cut"), Triangulation.AddHole({ 22, 27, 77, 72 }));
+			TestTrue(TEXT("Refined"), Triangulation.Refine(30.0, [](const FVector2D&) { return 0.5; }, 200000));
+			TestTrue(TEXT("Valid"), Triangulation.Validate(true));
+			TestTrue(TEXT("Angle"), GetMinAngle(Triangulation) >= 30.0 - KINDA_SMALL_NUMBER);
+
+			int32 Inside = 0;
+			for (const FGenTriangle& Triangle : Triangulation.Triangles)
+			{
+				if (Triangle.IsFreeSlot() || !Triangle.Enabled) continue;
+
+				const FVector2D Centroid = (Triangulation.Points[Triangle.Verts[0]] + Triangulation.Points[Triangle.Verts[1]] + Triangulation.Points[Triangle.Verts[2]]) / 3.0;
+				Inside += Centroid.X > 2.0 && Centroid.X < 7.0 && Centroid.Y > 2.0 && Centroid.Y < 7.0;
+			}
+			TestEqual(TEXT("Triangles inside"), Inside, 0);
+
+			// The grid points under the hole stay unused, refinement only adds points in the domain
+			for (int32 Index = 100; Index < Triangulation.Points.Num(); Index++)
+			{
+				const FVector2D& Point = Triangulation.Points[Index];
+				Inside += Point.X > 2.0 && Point.X < 7.0 && Point.Y > 2.0 && Point.Y < 7.0;
+			}
+			TestEqual(TEXT("Points inside"), Inside, 0);
+		});
+
+		It("should stop at the triangle budget", [this]()
+		{
+			Triangulation.QHull(MakeUniformCloud(100, 12), -1, true);
+			TestFalse(TEXT("Refined"), Triangulation.Refine(30.0, [](const FVector2D&) { return 0.01; }, 1000));
+			TestTrue(TEXT("Within budget"), GetUsedTriangles(Triangulation) <= 1000);
+			TestTrue(TEXT("Used budget"), GetUsedTriangles(Triangulation) > 990);
+			TestTrue(TEXT("Valid"), Triangulation.Validate(true));
+		});
+	});
+
+	Describe("Serialize", [this]()
+	{
+		BeforeEach([this]()
+		{
+			Triangulation.QHull(MakeUniformCloud(1000, 9), -1, true);
+			Triangulation.AddConstraint(0, 1);
+			Triangulation.RemovePoint(2);
+		});
+
+		It("should round trip triangles, constraints and free slots", [this]()
+		{
+			TArray<uint8> Bytes;
+			FMemoryWriter Writer(Bytes);
+			Triangulation.Serialize(Writer);
+
+			FTriangulation2D Loaded;
+			FMemoryReader Reader(Bytes);
+			TestTrue(TEXT("Binary"), Loaded.Serialize(Reader));
+			TestFalse(TEXT("Error"), Reader.IsError());
+			TestTrue(TEXT("Valid"), Loaded.Validate(true));
+			TestTrue(TEXT("Same triangles"), GetCanonicalTriangles(Loaded) == GetCanonicalTriangles(Triangulation));
+			TestTrue(TEXT("Same points"), Loaded.Points == Triangulation.Points);
+			TestEqual(TEXT("Constraints"), Loaded.Constraints.Num(), Triangulation.Constraints.Num());
+		});
+
+		It("should reject out of range indices", [this]()
+		{
+			const int32 Used = Triangulation.Triangles.IndexOfByPredicate([](const FGenTriangle& Triangle) { return !Triangle.IsFreeSlot(); });
+			Triangulation.Triangles[Used].Verts[1] = Triangulation.Points.Num() + 3;
+
+			TArray<uint8> Bytes;
+			FMemoryWriter Writer(Bytes);
+			Triangulation.Serialize(Writer);
+
+			FTriangulation2D Loaded;
+			FMemoryReader Reader(Bytes);
+			Loaded.Serialize(Reader);
+			TestTrue(TEXT("Error"), Reader.IsError());
+			TestEqual(TEXT("Triangles"), Loaded.Triangles.Num(), 0);
+			TestEqual(TEXT("Points"), Loaded.Points.Num(), 0);
+		});
+
+		It("should leave packages without the version to tagged serialization", [this]()
+		{
+			TArray<uint8> Bytes;
+			FMemoryReader Reader(Bytes, true);
+			TestFalse(TEXT("Binary"), Triangulation.Serialize(Reader));
+		});
+	});
+}
+
+#endif
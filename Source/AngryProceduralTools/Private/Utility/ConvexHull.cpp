@@ -0,0 +1,376 @@
+#include "Utility/ConvexHull.h"
+
+namespace
+{
+	FORCEINLINE uint64 MakeDirectedKey(int32 From, int32 To)
+	{
+		return (((uint64)(uint32)From) << 32) | (uint64)(uint32)To;
+	}
+
+	struct FHullFace
+	{
+		int32 Verts[3];
+		FVector Normal;
+		double Offset;
+
+		/** Cloud points outside of this face and the farthest of them */
+		TArray<int32> Outside;
+		int32 Farthest = INDEX_NONE;
+		double Distance = 0.0;
+
+		bool Removed = false;
+
+		FORCEINLINE double GetDistance(const FVector& Point) const { return (Normal | Point) - Offset; }
+	};
+
+	/** Quickhull over a cloud, records how volume and vertex count grew with every added point */
+	struct FQuickHull
+	{
+		TArrayView<const FVector> Cloud;
+		double Tolerance = 0.0;
+
+		TArray<FHullFace> Faces;
+		TMap<uint64, int32> Edges;
+
+		/** Faces with outside points by their farthest distance, removed faces are skipped when they come up */
+		TArray<TPair<double, int32>> Farthest;
+
+		/** Faces using each cloud point, points without faces aren't on the hull */
+		TArray<int32> FaceCounts;
+		int32 Vertices = 0;
+		double Volume = 0.0;
+
+		/** Cloud points in the order they were added with the volume and vertex count of the hull right after */
+		TArray<int32> Inserted;
+		TArray<double> Volumes;
+		TArray<int32> Counts;
+
+		explicit FQuickHull(TArrayView<const FVector> InCloud)
+			: Cloud(InCloud)
+		{
+		}
+
+		int32 AddFace(int32 A, int32 B, int32 C)
+		{
+			FHullFace Face;
+			Face.Verts[0] = A;
+			Face.Verts[1] = B;
+			Face.Verts[2] = C;
+			Face.Normal = ((Cloud[B] - Cloud[A]) ^ (Cloud[C] - Cloud[A])).GetSafeNormal();
+			Face.Offset = Face.Normal | Cloud[A];
+
+			const int32 Index = Faces.Emplace(MoveTemp(Face));
+			for (int32 Vert = 0; Vert < 3; Vert++)
+			{
+				const int32 Vertex = Faces[Index].Verts[Vert];
+				Vertices += (FaceCounts[Vertex]++ == 0) ? 1 : 0;
+				Edges.Add(MakeDirectedKey(Vertex, Faces[Index].Verts[(Vert + 1) % 3]), Index);
+			}
+			return Index;
+		}
+
+		void RemoveFace(int32 Index)
+		{
+			FHullFace& Face = Faces[Index];
+			Face.Removed = true;
+			for (int32 Vert = 0; Vert < 3; Vert++)
+			{
+				Vertices -= (--FaceCounts[Face.Verts[Vert]] == 0) ? 1 : 0;
+				Edges.Remove(MakeDirectedKey(Face.Verts[Vert], Face.Verts[(Vert + 1) % 3]));
+			}
+		}
+
+		void QueueFaces(int32 FirstFace)
+		{
+			for (int32 Index = FirstFace; Index < Faces.Num(); Index++)
+			{
+				if (Faces[Index].Farthest != INDEX_NONE)
+				{
+					Farthest.HeapPush(TPair<double, int32>(Faces[Index].Distance, Index), [](const TPair<double, int32>& A, const TPair<double, int32>& B) { return A.Key > B.Key; });
+				}
+			}
+		}
+
+		int32 PopFarthest()
+		{
+			while (Farthest.Num() > 0)
+			{
+				TPair<double, int32> Top;
+				Farthest.HeapPop(Top, [](const TPair<double, int32>& A, const TPair<double, int32>& B) { return A.Key > B.Key; }, false);
+				if (!Faces[Top.Value].Removed)
+				{
+					return Top.Value;
+				}
+			}
+			return INDEX_NONE;
+		}
+
+		// Hands a point to the face it is farthest outside of, points inside of all faces are dropped
+		void AssignOutside(int32 Point, int32 FirstFace)
+		{
+			int32 Best = INDEX_NONE;
+			double BestDistance = Tolerance;
+			for (int32 Index = FirstFace; Index < Faces.Num(); Index++)
+			{
+				const double Distance = Faces[Index].GetDistance(Cloud[Point]);
+				if (Distance > BestDistance)
+				{
+					BestDistance = Distance;
+					Best = Index;
+				}
+			}
+
+			if (Best != INDEX_NONE)
+			{
+				FHullFace& Face = Faces[Best];
+				Face.Outside.Emplace(Point);
+				if (BestDistance > Face.Distance)
+				{
+					Face.Distance = BestDistance;
+					Face.Farthest = Point;
+				}
+			}
+		}
+
+		bool Run()
+		{
+			const int32 Num = Cloud.Num();
+			if (Num < 4)
+			{
+				return false;
+			}
+
+			FBox Bounds(ForceInit);
+			int32 Extremes[6] = { 0, 0, 0, 0, 0, 0 };
+			for (int32 Index = 0; Index < Num; Index++)
+			{
+				Bounds += Cloud[Index];
+				for (int32 Axis = 0; Axis < 3; Axis++)
+				{
+					if (Cloud[Index][Axis] < Cloud[Extremes[Axis * 2]][Axis]) Extremes[Axis * 2] = Index;
+					if (Cloud[Index][Axis] > Cloud[Extremes[Axis * 2 + 1]][Axis]) Extremes[Axis * 2 + 1] = Index;
+				}
+			}
+			Tolerance = Bounds.GetExtent().GetMax() * 1e-9;
+
+			// Seed tetrahedron from the widest extreme pair, the point farthest from their line and the point farthest from that plane
+			int32 I0 = Extremes[0];
+			int32 I1 = Extremes[1];
+			for (int32 Axis = 1; Axis < 3; Axis++)
+			{
+				if ((Cloud[Extremes[Axis * 2 + 1]] - Cloud[Extremes[Axis * 2]]).SizeSquared() > (Cloud[I1] - Cloud[I0]).SizeSquared())
+				{
+					I0 = Extremes[Axis * 2];
+					I1 = Extremes[Axis * 2 + 1];
+				}
+			}
+
+			const FVector Line = (Cloud[I1] - Cloud[I0]).GetSafeNormal();
+			int32 I2 = INDEX_NONE;
+			double Farthest = Tolerance;
+			for (int32 Index = 0; Index < Num; Index++)
+			{
+				const double Distance = ((Cloud[Index] - Cloud[I0]) ^ Line).Size();
+				if (Distance > Farthest)
+				{
+					Farthest = Distance;
+					I2 = Index;
+				}
+			}
+
+			if (I2 == INDEX_NONE)
+			{
+				return false;
+			}
+
+			const FVector Normal = ((Cloud[I1] - Cloud[I0]) ^ (Cloud[I2] - Cloud[I0])).GetSafeNormal();
+			int32 I3 = INDEX_NONE;
+			Farthest = Tolerance;
+			for (int32 Index = 0; Index < Num; Index++)
+			{
+				const double Distance = FMath::Abs((Cloud[Index] - Cloud[I0]) | Normal);
+				if (Distance > Farthest)
+				{
+					Farthest = Distance;
+					I3 = Index;
+				}
+			}
+
+			if (I3 == INDEX_NONE)
+			{
+				return false;
+			}
+
+			// Base faces away from the apex
+			if (((Cloud[I3] - Cloud[I0]) | Normal) > 0.0)
+			{
+				Swap(I1, I2);
+			}
+
+			FaceCounts.Init(0, Num);
+			AddFace(I0, I1, I2);
+			AddFace(I0, I3, I1);
+			AddFace(I1, I3, I2);
+			AddFace(I2, I3, I0);
+			Volume = FMath::Abs(((Cloud[I1] - Cloud[I0]) ^ (Cloud[I2] - Cloud[I0])) | (Cloud[I3] - Cloud[I0])) / 6.0;
+
+			Inserted.Append({ I0, I1, I2, I3 });
+			Volumes.Init(0.0, 3);
+			Volumes.Emplace(Volume);
+			Counts.Append({ 1, 2, 3, 4 });
+
+			for (int32 Index = 0; Index < Num; Index++)
+			{
+				if (Index != I0 && Index != I1 && Index != I2 && Index != I3)
+				{
+					AssignOutside(Index, 0);
+				}
+			}
+			QueueFaces(0);
+
+			TArray<int32> Visible;
+			TArray<TPair<int32, int32>> Horizon;
+			TArray<int32> Orphans;
+			for (;;)
+			{
+				// Always grow towards the farthest point so every step removes as much missing volume as it can
+				const int32 Best = PopFarthest();
+				if (Best == INDEX_NONE)
+				{
+					break;
+				}
+
+				const int32 Apex = Faces[Best].Farthest;
+				const FVector& Point = Cloud[Apex];
+
+				// Faces the apex sees are connected, walk them from the face it was outside of and collect the edges where visibility ends
+				Visible.Reset();
+				Horizon.Reset();
+				Visible.Emplace(Best);
+				Faces[Best].Removed = true;
+				for (int32 Cursor = 0; Cursor < Visible.Num(); Cursor++)
+				{
+					const FHullFace& Face = Faces[Visible[Cursor]];
+					for (int32 Vert = 0; Vert < 3; Vert++)
+					{
+						const int32 From = Face.Verts[Vert];
+						const int32 To = Face.Verts[(Vert + 1) % 3];
+						const int32 Neighbour = Edges.FindChecked(MakeDirectedKey(To, From));
+						if (Faces[Neighbour].Removed)
+						{
+							continue;
+						}
+
+						if (Faces[Neighbour].GetDistance(Point) > Tolerance)
+						{
+							Faces[Neighbour].Removed = true;
+							Visible.Emplace(Neighbour);
+						}
+						else
+						{
+							Horizon.Emplace(From, To);
+						}
+					}
+				}
+
+				// Visible cone is replaced by triangles from the horizon to the apex
+				Orphans.Reset();
+				for (int32 Index : Visible)
+				{
+					Volume += FMath::Abs(Faces[Index].GetDistance(Point)) * ((Cloud[Faces[Index].Verts[1]] - Cloud[Faces[Index].Verts[0]]) ^ (Cloud[Faces[Index].Verts[2]] - Cloud[Faces[Index].Verts[0]])).Size() / 6.0;
+					RemoveFace(Index);
+					Orphans.Append(Faces[Index].Outside);
+					Faces[Index].Outside.Empty();
+				}
+
+				const int32 FirstFace = Faces.Num();
+				for (const TPair<int32, int32>& Edge : Horizon)
+				{
+					AddFace(Edge.Key, Edge.Value, Apex);
+				}
+
+				for (int32 Orphan : Orphans)
+				{
+					if (Orphan != Apex)
+					{
+						AssignOutside(Orphan, FirstFace);
+					}
+				}
+				QueueFaces(FirstFace);
+
+				Inserted.Emplace(Apex);
+				Volumes.Emplace(Volume);
+				Counts.Emplace(Vertices);
+			}
+			return true;
+		}
+
+		void Export(FConvexHull& Hull) const
+		{
+			TArray<int32> Remap;
+			Remap.Init(INDEX_NONE, Cloud.Num());
+			for (int32 Point : Inserted)
+			{
+				if (FaceCounts[Point] > 0 && Remap[Point] == INDEX_NONE)
+				{
+					Remap[Point] = Hull.Points.Emplace(Cloud[Point]);
+				}
+			}
+
+			for (const FHullFace& Face : Faces)
+			{
+				if (!Face.Removed)
+				{
+					Hull.Faces.Emplace(FIntVector(Remap[Face.Verts[0]], Remap[Face.Verts[1]], Remap[Face.Verts[2]]));
+				}
+			}
+			Hull.Volume = Volume;
+		}
+	};
+}
+
+bool FConvexHull::Build(TArrayView<const FVector> Cloud, int32 MaxVertices, double MaxVolumeError)
+{
+	Points.Reset();
+	Faces.Reset();
+	Volume = 0.0;
+	VolumeError = 0.0;
+
+	FQuickHull Full(Cloud);
+	if (!Full.Run())
+	{
+		return false;
+	}
+
+	// Walk the insertion order until the hull is close enough or the next point would exceed the budget, the hull of that prefix is that intermediate hull
+	const int32 Steps = Full.Inserted.Num();
+	const int32 Budget = (MaxVertices > 0) ? FMath::Max(MaxVertices, 4) : MAX_int32;
+	int32 Step = 3;
+	while (Step < Steps - 1 && Full.Volume - Full.Volumes[Step] > MaxVolumeError * Full.Volume && Full.Counts[Step + 1] <= Budget)
+	{
+		Step++;
+	}
+
+	if (Step == Steps - 1)
+	{
+		Full.Export(*this);
+		return true;
+	}
+
+	TArray<FVector> Prefix;
+	Prefix.Reserve(Step + 1);
+	for (int32 Index = 0; Index <= Step; Index++)
+	{
+		Prefix.Emplace(Cloud[Full.Inserted[Index]]);
+	}
+
+	FQuickHull Reduced(Prefix);
+	if (!Reduced.Run())
+	{
+		Full.Export(*this);
+		return true;
+	}
+	Reduced.Export(*this);
+	VolumeError = (Full.Volume > 0.0) ? (Full.Volume - Volume) / Full.Volume : 0.0;
+	return true;
+}
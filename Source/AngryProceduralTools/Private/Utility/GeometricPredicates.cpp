@@ -0,0 +1,394 @@
+#include "Utility/GeometricPredicates.h"
+#include "TriangulationStats.h"
+#include "Algo/Sort.h"
+
+namespace
+{
+	// Machine epsilon for doubles and Dekker's splitter 2^ceil(53/2) + 1
+	constexpr double Epsilon = 1.1102230246251565e-16;
+	constexpr double Splitter = 134217729.0;
+
+	// Error bounds of the plain double evaluation, see Shewchuk "Adaptive Precision Floating-Point Arithmetic and Fast Robust Geometric Predicates"
+	constexpr double Orient2DBound = (3.0 + 16.0 * Epsilon) * Epsilon;
+	constexpr double InCircleBound = (10.0 + 96.0 * Epsilon) * Epsilon;
+	constexpr double Orient3DBound = (7.0 + 56.0 * Epsilon) * Epsilon;
+
+	FORCEINLINE void TwoSum(double A, double B, double& X, double& Y)
+	{
+		X = A + B;
+		const double BVirtual = X - A;
+		const double AVirtual = X - BVirtual;
+		Y = (A - AVirtual) + (B - BVirtual);
+	}
+
+	FORCEINLINE void FastTwoSum(double A, double B, double& X, double& Y)
+	{
+		X = A + B;
+		Y = B - (X - A);
+	}
+
+	FORCEINLINE void Split(double A, double& High, double& Low)
+	{
+		const double C = Splitter * A;
+		High = C - (C - A);
+		Low = A - High;
+	}
+
+	FORCEINLINE void TwoProduct(double A, double B, double& X, double& Y)
+	{
+		X = A * B;
+		double AHigh, ALow, BHigh, BLow;
+		Split(A, AHigh, ALow);
+		Split(B, BHigh, BLow);
+		Y = ALow * BLow - (((X - AHigh * BHigh) - ALow * BHigh) - AHigh * BLow);
+	}
+
+	// Sum of non-overlapping doubles sorted by increasing magnitude, zero components are removed
+	struct FExpansion
+	{
+		TArray<double, TInlineAllocator<16>> Components;
+
+		FExpansion() {}
+		explicit FExpansion(double Value)
+		{
+			if (Value != 0.0)
+			{
+				Components.Emplace(Value);
+			}
+		}
+
+		static FExpansion Diff(double A, double B)
+		{
+			FExpansion Out;
+			double X, Y;
+			TwoSum(A, -B, X, Y);
+			if (Y != 0.0) Out.Components.Emplace(Y);
+			if (X != 0.0) Out.Components.Emplace(X);
+			return Out;
+		}
+
+		FExpansion Grow(double B) const
+		{
+			FExpansion Out;
+			double Q = B;
+			for (double Component : Components)
+			{
+				double H;
+				TwoSum(Q, Component, Q, H);
+				if (H != 0.0) Out.Components.Emplace(H);
+			}
+			if (Q != 0.0) Out.Components.Emplace(Q);
+			return Out;
+		}
+
+		FExpansion Scale(double B) const
+		{
+			FExpansion Out;
+			if (Components.Num() == 0)
+			{
+				return Out;
+			}
+
+			double Q, H;
+			TwoProduct(Components[0], B, Q, H);
+			if (H != 0.0) Out.Components.Emplace(H);
+
+			for (int32 Index = 1; Index < Components.Num(); Index++)
+			{
+				double High, Low, Sum;
+				TwoProduct(Components[Index], B, High, Low);
+				TwoSum(Q, Low, Sum, H);
+				if (H != 0.0) Out.Components.Emplace(H);
+				FastTwoSum(High, Sum, Q, H);
+				if (H != 0.0) Out.Components.Emplace(H);
+			}
+			if (Q != 0.0) Out.Components.Emplace(Q);
+			return Out;
+		}
+
+		FExpansion operator+(const FExpansion& Other) const
+		{
+			FExpansion Out = *this;
+			for (double Component : Other.Components)
+			{
+				Out = Out.Grow(Component);
+			}
+			return Out;
+		}
+
+		FExpansion operator-() const
+		{
+			FExpansion Out = *this;
+			for (double& Component : Out.Components)
+			{
+				Component = -Component;
+			}
+			return Out;
+		}
+
+		FExpansion operator-(const FExpansion& Other) const
+		{
+			return *this + (-Other);
+		}
+
+		FExpansion operator*(const FExpansion& Other) const
+		{
+			FExpansion Out;
+			for (double Component : Other.Components)
+			{
+				Out = Out + Scale(Component);
+			}
+			return Out;
+		}
+
+		// Largest component dominates, so the sum has the exact sign
+		double Estimate() const
+		{
+			double Sum = 0.0;
+			for (double Component : Components)
+			{
+				Sum += Component;
+			}
+			return Sum;
+		}
+	};
+}
+
+double FGeometricPredicates::Orient2D(const FVector2D& A, const FVector2D& B, const FVector2D& C)
+{
+	const double Left = (A.X - C.X) * (B.Y - C.Y);
+	const double Right = (A.Y - C.Y) * (B.X - C.X);
+	const double Det = Left - Right;
+
+	// Differing signs can't cancel
+	double Sum;
+	if (Left > 0.0)
+	{
+		if (Right <= 0.0) return Det;
+		Sum = Left + Right;
+	}
+	else if (Left < 0.0)
+	{
+		if (Right >= 0.0) return Det;
+		Sum = -Left - Right;
+	}
+	else
+	{
+		return Det;
+	}
+
+	if (FMath::Abs(Det) >= Orient2DBound * Sum)
+	{
+		return Det;
+	}
+	return Orient2DExact(A, B, C);
+}
+
+double FGeometricPredicates::InCircle(const FVector2D& A, const FVector2D& B, const FVector2D& C, const FVector2D& D)
+{
+	const double ADX = A.X - D.X, ADY = A.Y - D.Y;
+	const double BDX = B.X - D.X, BDY = B.Y - D.Y;
+	const double CDX = C.X - D.X, CDY = C.Y - D.Y;
+
+	const double BDXCDY = BDX * CDY, CDXBDY = CDX * BDY;
+	const double CDXADY = CDX * ADY, ADXCDY = ADX * CDY;
+	const double ADXBDY = ADX * BDY, BDXADY = BDX * ADY;
+
+	const double ALift = ADX * ADX + ADY * ADY;
+	const double BLift = BDX * BDX + BDY * BDY;
+	const double CLift = CDX * CDX + CDY * CDY;
+
+	const double Det =
+		ALift * (BDXCDY - CDXBDY) +
+		BLift * (CDXADY - ADXCDY) +
+		CLift * (ADXBDY - BDXADY);
+
+	const double Permanent =
+		(FMath::Abs(BDXCDY) + FMath::Abs(CDXBDY)) * ALift +
+		(FMath::Abs(CDXADY) + FMath::Abs(ADXCDY)) * BLift +
+		(FMath::Abs(ADXBDY) + FMath::Abs(BDXADY)) * CLift;
+
+	if (FMath::Abs(Det) > InCircleBound * Permanent)
+	{
+		return Det;
+	}
+	return InCircleExact(A, B, C, D);
+}
+
+double FGeometricPredicates::InCirclePerturbed(const FVector2D& A, const FVector2D& B, const FVector2D& C, const FVector2D& D)
+{
+	const double Det = InCircle(A, B, C, D);
+	if (Det != 0.0)
+	{
+		return Det;
+	}
+
+	// Derivative of the determinant by each lift is the signed orientation of the other three points
+	const FVector2D* Lifted[] = { &A, &B, &C, &D };
+	const double Cofactors[] = { Orient2D(B, C, D), -Orient2D(A, C, D), Orient2D(A, B, D), -Orient2D(A, B, C) };
+
+	int32 Order[] = { 0, 1, 2, 3 };
+	Algo::Sort(Order, [&Lifted](int32 X, int32 Y)
+	{
+		return Lifted[X]->X < Lifted[Y]->X || (Lifted[X]->X == Lifted[Y]->X && Lifted[X]->Y < Lifted[Y]->Y);
+	});
+
+	// Lexicographically smaller points are lifted by infinitesimally larger amounts
+	for (int32 Index : Order)
+	{
+		if (Cofactors[Index] != 0.0)
+		{
+			return Cofactors[Index];
+		}
+	}
+	return 0.0;
+}
+
+double FGeometricPredicates::Orient3D(const FVector& A, const FVector& B, const FVector& C, const FVector& D)
+{
+	const double ADX = A.X - D.X, ADY = A.Y - D.Y, ADZ = A.Z - D.Z;
+	const double BDX = B.X - D.X, BDY = B.Y - D.Y, BDZ = B.Z - D.Z;
+	const double CDX = C.X - D.X, CDY = C.Y - D.Y, CDZ = C.Z - D.Z;
+
+	const double BDXCDY = BDX * CDY, CDXBDY = CDX * BDY;
+	const double CDXADY = CDX * ADY, ADXCDY = ADX * CDY;
+	const double ADXBDY = ADX * BDY, BDXADY = BDX * ADY;
+
+	const double Det =
+		ADZ * (BDXCDY - CDXBDY) +
+		BDZ * (CDXADY - ADXCDY) +
+		CDZ * (ADXBDY - BDXADY);
+
+	const double Permanent =
+		(FMath::Abs(BDXCDY) + FMath::Abs(CDXBDY)) * FMath::Abs(ADZ) +
+		(FMath::Abs(CDXADY) + FMath::Abs(ADXCDY)) * FMath::Abs(BDZ) +
+		(FMath::Abs(ADXBDY) + FMath::Abs(BDXADY)) * FMath::Abs(CDZ);
+
+	if (FMath::Abs(Det) > Orient3DBound * Permanent)
+	{
+		return Det;
+	}
+	return Orient3DExact(A, B, C, D);
+}
+
+bool FGeometricPredicates::IsCollinear(const FVector& A, const FVector& B, const FVector& C)
+{
+	// Collinear in 3D iff collinear in all three axis projections
+	return
+		Orient2D(FVector2D(A.X, A.Y), FVector2D(B.X, B.Y), FVector2D(C.X, C.Y)) == 0.0 &&
+		Orient2D(FVector2D(A.Y, A.Z), FVector2D(B.Y, B.Z), FVector2D(C.Y, C.Z)) == 0.0 &&
+		Orient2D(FVector2D(A.Z, A.X), FVector2D(B.Z, B.X), FVector2D(C.Z, C.X)) == 0.0;
+}
+
+void FGeometricPredicates::ClassifyInCircles(TArrayView<const FVector2D> Points, TArrayView<const FIntVector4> Quads, TArrayView<int8> Signs)
+{
+	check(Quads.Num() == Signs.Num());
+
+	const VectorRegister4Double InCircleBounds = MakeVectorRegisterDouble(InCircleBound, InCircleBound, InCircleBound, InCircleBound);
+	const VectorRegister4Double Orient2DBounds = MakeVectorRegisterDouble(Orient2DBound, Orient2DBound, Orient2DBound, Orient2DBound);
+
+	const int32 Num = Quads.Num();
+	for (int32 Base = 0; Base < Num; Base += 4)
+	{
+		// Same differences as the scalar filters so their error bounds hold, the last batch repeats its final quad
+		alignas(32) double ADX[4], ADY[4], BDX[4], BDY[4], CDX[4], CDY[4];
+		alignas(32) double ACX[4], ACY[4], BCX[4], BCY[4];
+		for (int32 Lane = 0; Lane < 4; Lane++)
+		{
+			const FIntVector4& Quad = Quads[FMath::Min(Base + Lane, Num - 1)];
+			const FVector2D& A = Points[Quad.X];
+			const FVector2D& B = Points[Quad.Y];
+			const FVector2D& C = Points[Quad.Z];
+			const FVector2D& D = Points[Quad.W];
+			ADX[Lane] = A.X - D.X; ADY[Lane] = A.Y - D.Y;
+			BDX[Lane] = B.X - D.X; BDY[Lane] = B.Y - D.Y;
+			CDX[Lane] = C.X - D.X; CDY[Lane] = C.Y - D.Y;
+			ACX[Lane] = A.X - C.X; ACY[Lane] = A.Y - C.Y;
+			BCX[Lane] = B.X - C.X; BCY[Lane] = B.Y - C.Y;
+		}
+
+		// No fused multiply-add, the bounds assume every operation rounds once
+		const VectorRegister4Double OrientLeft = VectorMultiply(VectorLoadAligned(ACX), VectorLoadAligned(BCY));
+		const VectorRegister4Double OrientRight = VectorMultiply(VectorLoadAligned(ACY), VectorLoadAligned(BCX));
+		const VectorRegister4Double Orient = VectorSubtract(OrientLeft, OrientRight);
+		const VectorRegister4Double OrientSum = VectorAdd(VectorAbs(OrientLeft), VectorAbs(OrientRight));
+
+		const VectorRegister4Double AX = VectorLoadAligned(ADX), AY = VectorLoadAligned(ADY);
+		const VectorRegister4Double BX = VectorLoadAligned(BDX), BY = VectorLoadAligned(BDY);
+		const VectorRegister4Double CX = VectorLoadAligned(CDX), CY = VectorLoadAligned(CDY);
+
+		const VectorRegister4Double BXCY = VectorMultiply(BX, CY), CXBY = VectorMultiply(CX, BY);
+		const VectorRegister4Double CXAY = VectorMultiply(CX, AY), AXCY = VectorMultiply(AX, CY);
+		const VectorRegister4Double AXBY = VectorMultiply(AX, BY), BXAY = VectorMultiply(BX, AY);
+
+		const VectorRegister4Double ALift = VectorAdd(VectorMultiply(AX, AX), VectorMultiply(AY, AY));
+		const VectorRegister4Double BLift = VectorAdd(VectorMultiply(BX, BX), VectorMultiply(BY, BY));
+		const VectorRegister4Double CLift = VectorAdd(VectorMultiply(CX, CX), VectorMultiply(CY, CY));
+
+		const VectorRegister4Double Det = VectorAdd(VectorAdd(
+			VectorMultiply(ALift, VectorSubtract(BXCY, CXBY)),
+			VectorMultiply(BLift, VectorSubtract(CXAY, AXCY))),
+			VectorMultiply(CLift, VectorSubtract(AXBY, BXAY)));
+
+		const VectorRegister4Double Permanent = VectorAdd(VectorAdd(
+			VectorMultiply(VectorAdd(VectorAbs(BXCY), VectorAbs(CXBY)), ALift),
+			VectorMultiply(VectorAdd(VectorAbs(CXAY), VectorAbs(AXCY)), BLift)),
+			VectorMultiply(VectorAdd(VectorAbs(AXBY), VectorAbs(BXAY)), CLift));
+
+		const int32 Certain =
+			VectorMaskBits(VectorCompareGT(VectorAbs(Det), VectorMultiply(InCircleBounds, Permanent))) &
+			VectorMaskBits(VectorCompareGE(VectorAbs(Orient), VectorMultiply(Orient2DBounds, OrientSum)));
+
+		alignas(32) double Dets[4], Orients[4];
+		VectorStoreAligned(Det, Dets);
+		VectorStoreAligned(Orient, Orients);
+		for (int32 Lane = 0; Lane < 4 && Base + Lane < Num; Lane++)
+		{
+			const bool Trusted = (Certain & (1 << Lane)) && Orients[Lane] != 0.0;
+			Signs[Base + Lane] = Trusted ? (((Dets[Lane] > 0.0) == (Orients[Lane] > 0.0)) ? 1 : -1) : 0;
+		}
+	}
+}
+
+double FGeometricPredicates::Orient2DExact(const FVector2D& A, const FVector2D& B, const FVector2D& C)
+{
+	INC_DWORD_STAT(STAT_AngryTriangulation_ExactPredicates);
+
+	const FExpansion ACX = FExpansion::Diff(A.X, C.X), ACY = FExpansion::Diff(A.Y, C.Y);
+	const FExpansion BCX = FExpansion::Diff(B.X, C.X), BCY = FExpansion::Diff(B.Y, C.Y);
+	return (ACX * BCY - ACY * BCX).Estimate();
+}
+
+double FGeometricPredicates::InCircleExact(const FVector2D& A, const FVector2D& B, const FVector2D& C, const FVector2D& D)
+{
+	INC_DWORD_STAT(STAT_AngryTriangulation_ExactPredicates);
+
+	const FExpansion ADX = FExpansion::Diff(A.X, D.X), ADY = FExpansion::Diff(A.Y, D.Y);
+	const FExpansion BDX = FExpansion::Diff(B.X, D.X), BDY = FExpansion::Diff(B.Y, D.Y);
+	const FExpansion CDX = FExpansion::Diff(C.X, D.X), CDY = FExpansion::Diff(C.Y, D.Y);
+
+	const FExpansion ALift = ADX * ADX + ADY * ADY;
+	const FExpansion BLift = BDX * BDX + BDY * BDY;
+	const FExpansion CLift = CDX * CDX + CDY * CDY;
+
+	const FExpansion Det =
+		ALift * (BDX * CDY - CDX * BDY) +
+		BLift * (CDX * ADY - ADX * CDY) +
+		CLift * (ADX * BDY - BDX * ADY);
+	return Det.Estimate();
+}
+
+double FGeometricPredicates::Orient3DExact(const FVector& A, const FVector& B, const FVector& C, const FVector& D)
+{
+	INC_DWORD_STAT(STAT_AngryTriangulation_ExactPredicates);
+
+	const FExpansion ADX = FExpansion::Diff(A.X, D.X), ADY = FExpansion::Diff(A.Y, D.Y), ADZ = FExpansion::Diff(A.Z, D.Z);
+	const FExpansion BDX = FExpansion::Diff(B.X, D.X), BDY = FExpansion::Diff(B.Y, D.Y), BDZ = FExpansion::Diff(B.Z, D.Z);
+	const FExpansion CDX = FExpansion::Diff(C.X, D.X), CDY = FExpansion::Diff(C.Y, D.Y), CDZ = FExpansion::Diff(C.Z, D.Z);
+
+	const FExpansion Det =
+		ADZ * (BDX * CDY - CDX * BDY) +
+		BDZ * (CDX * ADY - ADX * CDY) +
+		CDZ * (ADX * BDY - BDX * ADY);
+	return Det.Estimate();
+}
@@ -0,0 +1,374 @@
+#include "Utility/TriangleBVH.h"
+#include "Utility/Triangulation.h"
+#include "Algo/Sort.h"
+
+namespace
+{
+	// Few primitives per leaf keep the exact tests cheap compared to the box tests
+	constexpr int32 LeafSize = 4;
+
+	bool SegmentOverlaps(const FBox& Bounds, const FVector& From, const FVector& Direction, double MaxTime)
+	{
+		double Near = 0.0;
+		double Far = MaxTime;
+		for (int32 Axis = 0; Axis < 3; Axis++)
+		{
+			if (Direction[Axis] == 0.0)
+			{
+				if (From[Axis] < Bounds.Min[Axis] || From[Axis] > Bounds.Max[Axis])
+				{
+					return false;
+				}
+				continue;
+			}
+
+			double Enter = (Bounds.Min[Axis] - From[Axis]) / Direction[Axis];
+			double Leave = (Bounds.Max[Axis] - From[Axis]) / Direction[Axis];
+			if (Enter > Leave)
+			{
+				Swap(Enter, Leave);
+			}
+
+			Near = FMath::Max(Near, Enter);
+			Far = FMath::Min(Far, Leave);
+			if (Near > Far)
+			{
+				return false;
+			}
+		}
+		return true;
+	}
+
+	enum class ERayHit : uint8
+	{
+		Miss,
+		Hit,
+		/** Close enough to an edge, a vertex or the triangle plane that a neighbouring triangle might count the same crossing */
+		Ambiguous
+	};
+
+	ERayHit ClassifyRayHit(const FVector& From, const FVector& Direction, const FVector& A, const FVector& B, const FVector& C)
+	{
+		// Relative to the barycentric range, far above rounding and far below any feature a mesh would have
+		constexpr double Tolerance = 1e-9;
+
+		const FVector AB = B - A;
+		const FVector AC = C - A;
+		const FVector Cross = Direction ^ AC;
+		const double Det = AB | Cross;
+		const double Scale = Direction.Size() * AB.Size() * AC.Size();
+		if (FMath::Abs(Det) <= Tolerance * Scale)
+		{
+			// Grazing the plane only matters where the ray actually runs through the triangle's slab
+			const FVector Normal = AB ^ AC;
+			const double Start = (From - A) | Normal;
+			const double End = (From + Direction - A) | Normal;
+			return (Start * End <= 0.0) ? ERayHit::Ambiguous : ERayHit::Miss;
+		}
+
+		const double Inv = 1.0 / Det;
+		const FVector Offset = From - A;
+		const double U = (Offset | Cross) * Inv;
+		const FVector Perp = Offset ^ AB;
+		const double V = (Direction | Perp) * Inv;
+		const double Time = (AC | Perp) * Inv;
+		if (U < -Tolerance || V < -Tolerance || U + V > 1.0 + Tolerance || Time < 0.0 || Time > 1.0)
+		{
+			return ERayHit::Miss;
+		}
+		return (U <= Tolerance || V <= Tolerance || U + V >= 1.0 - Tolerance) ? ERayHit::Ambiguous : ERayHit::Hit;
+	}
+
+	bool SegmentHitsTriangle(const FVector& From, const FVector& Direction, const FVector& A, const FVector& B, const FVector& C, double& Time)
+	{
+		const FVector AB = B - A;
+		const FVector AC = C - A;
+		const FVector Cross = Direction ^ AC;
+		const double Det = AB | Cross;
+		if (Det == 0.0)
+		{
+			return false;
+		}
+
+		// Barycentric coordinates and time along the segment, both sides of the triangle count
+		const double Inv = 1.0 / Det;
+		const FVector Offset = From - A;
+		const double U = (Offset | Cross) * Inv;
+		if (U < 0.0 || U > 1.0)
+		{
+			return false;
+		}
+
+		const FVector Perp = Offset ^ AB;
+		const double V = (Direction | Perp) * Inv;
+		if (V < 0.0 || U + V > 1.0)
+		{
+			return false;
+		}
+
+		Time = (AC | Perp) * Inv;
+		return 0.0 <= Time && Time <= 1.0;
+	}
+}
+
+void FTriangleBVH::Build(const FTriangulation3D& Triangulation)
+{
+	Points = Triangulation.Points;
+	Primitives.Reset();
+	Sources.Reset();
+
+	const int32 Num = Triangulation.Triangles.Num();
+	for (int32 Index = 0; Index < Num; Index++)
+	{
+		const FGenTriangle& Triangle = Triangulation.Triangles[Index];
+		if (Triangle.Enabled)
+		{
+			Primitives.Emplace(FIntVector(Triangle.Verts[0], Triangle.Verts[1], Triangle.Verts[2]));
+			Sources.Emplace(Index);
+		}
+	}
+	BuildNodes();
+}
+
+void FTriangleBVH::Build(TArrayView<const FVector> Polyline, bool Closed)
+{
+	Points = Polyline;
+	Primitives.Reset();
+	Sources.Reset();
+
+	const int32 Num = Points.Num();
+	const int32 SegmentNum = (Closed && Num > 2) ? Num : Num - 1;
+	for (int32 Index = 0; Index < SegmentNum; Index++)
+	{
+		const int32 Next = (Index + 1) % Num;
+		Primitives.Emplace(FIntVector(Index, Next, Next));
+		Sources.Emplace(Index);
+	}
+	BuildNodes();
+}
+
+FBox FTriangleBVH::GetBounds(int32 Primitive) const
+{
+	const FIntVector& Verts = Primitives[Primitive];
+
+	FBox Bounds(ForceInit);
+	Bounds += Points[Verts.X];
+	Bounds += Points[Verts.Y];
+	Bounds += Points[Verts.Z];
+	return Bounds;
+}
+
+void FTriangleBVH::BuildNodes()
+{
+	Nodes.Reset();
+
+	const int32 Num = Primitives.Num();
+	if (Num == 0)
+	{
+		return;
+	}
+
+	TArray<FVector> Centers;
+	TArray<int32> Order;
+	Centers.SetNumUninitialized(Num);
+	Order.SetNumUninitialized(Num);
+	for (int32 Index = 0; Index < Num; Index++)
+	{
+		Centers[Index] = GetBounds(Index).GetCenter();
+		Order[Index] = Index;
+	}
+
+	struct FRange
+	{
+		int32 Parent, Start, Num;
+		bool Right;
+	};
+
+	// Nodes are created when popped, popping left before right keeps the left child directly after its parent
+	TArray<FRange> Stack;
+	Stack.Emplace(FRange({ INDEX_NONE, 0, Num, false }));
+	Nodes.Reserve(Num / LeafSize * 2 + 1);
+	while (Stack.Num() > 0)
+	{
+		const FRange Range = Stack.Pop(false);
+		const int32 Index = Nodes.AddUninitialized();
+		if (Range.Right)
+		{
+			Nodes[Range.Parent].Offset = Index;
+		}
+
+		FBox Bounds(ForceInit);
+		FBox CenterBounds(ForceInit);
+		for (int32 Item = Range.Start; Item < Range.Start + Range.Num; Item++)
+		{
+			Bounds += GetBounds(Order[Item]);
+			CenterBounds += Centers[Order[Item]];
+		}
+
+		FNode& Node = Nodes[Index];
+		Node.Bounds = Bounds;
+		if (Range.Num <= LeafSize)
+		{
+			Node.Offset = Range.Start;
+			Node.Num = Range.Num;
+			continue;
+		}
+		Node.Offset = INDEX_NONE;
+		Node.Num = 0;
+
+		// Median split along the widest axis of the centers, balanced no matter how primitives are distributed
+		const FVector Size = CenterBounds.GetSize();
+		const int32 Axis = (Size.X >= Size.Y && Size.X >= Size.Z) ? 0 : (Size.Y >= Size.Z ? 1 : 2);
+		Algo::Sort(MakeArrayView(Order.GetData() + Range.Start, Range.Num), [&Centers, Axis](int32 A, int32 B)
+		{
+			return Centers[A][Axis] < Centers[B][Axis] || (Centers[A][Axis] == Centers[B][Axis] && A < B);
+		});
+
+		const int32 Half = Range.Num / 2;
+		Stack.Emplace(FRange({ Index, Range.Start + Half, Range.Num - Half, true }));
+		Stack.Emplace(FRange({ Index, Range.Start, Half, false }));
+	}
+
+	// Store primitives in leaf order so leaves read contiguous memory
+	TArray<FIntVector> Sorted;
+	TArray<int32> SortedSources;
+	Sorted.SetNumUninitialized(Num);
+	SortedSources.SetNumUninitialized(Num);
+	for (int32 Index = 0; Index < Num; Index++)
+	{
+		Sorted[Index] = Primitives[Order[Index]];
+		SortedSources[Index] = Sources[Order[Index]];
+	}
+	Primitives = MoveTemp(Sorted);
+	Sources = MoveTemp(SortedSources);
+}
+
+int32 FTriangleBVH::IntersectSegment(const FVector& From, const FVector& To, double& Time) const
+{
+	const FVector Direction = To - From;
+
+	int32 Best = INDEX_NONE;
+	Time = 1.0;
+	Traverse([&](const FBox& Bounds) { return SegmentOverlaps(Bounds, From, Direction, Time); }, [&](int32 Primitive)
+	{
+		if (IsSegment(Primitive))
+		{
+			return false;
+		}
+
+		// Nodes further along than the closest hit so far are skipped by the box test
+		const FIntVector& Verts = Primitives[Primitive];
+		double Hit;
+		if (SegmentHitsTriangle(From, Direction, Points[Verts.X], Points[Verts.Y], Points[Verts.Z], Hit) && (Best == INDEX_NONE || Hit < Time))
+		{
+			Best = Sources[Primitive];
+			Time = Hit;
+		}
+		return false;
+	});
+	return Best;
+}
+
+int32 FTriangleBVH::FindNearest(const FVector& Point, FVector& Closest) const
+{
+	int32 Best = INDEX_NONE;
+	double BestDistance = TNumericLimits<double>::Max();
+	if (Nodes.Num() == 0)
+	{
+		return Best;
+	}
+
+	// Nearer child first so the best distance shrinks early and prunes the other one, entries carry their box distance
+	TArray<TPair<int32, double>, TInlineAllocator<64>> Stack;
+	Stack.Emplace(0, Nodes[0].Bounds.ComputeSquaredDistanceToPoint(Point));
+	while (Stack.Num() > 0)
+	{
+		const TPair<int32, double> Entry = Stack.Pop(false);
+		if (Entry.Value > BestDistance)
+		{
+			continue;
+		}
+
+		const FNode& Node = Nodes[Entry.Key];
+		if (Node.Num == 0)
+		{
+			const int32 Left = Entry.Key + 1;
+			const int32 Right = Node.Offset;
+			const double LeftDistance = Nodes[Left].Bounds.ComputeSquaredDistanceToPoint(Point);
+			const double RightDistance = Nodes[Right].Bounds.ComputeSquaredDistanceToPoint(Point);
+			if (LeftDistance <= RightDistance)
+			{
+				Stack.Emplace(Right, RightDistance);
+				Stack.Emplace(Left, LeftDistance);
+			}
+			else
+			{
+				Stack.Emplace(Left, LeftDistance);
+				Stack.Emplace(Right, RightDistance);
+			}
+			continue;
+		}
+
+		for (int32 Primitive = Node.Offset; Primitive < Node.Offset + Node.Num; Primitive++)
+		{
+			const FIntVector& Verts = Primitives[Primitive];
+			const FVector Candidate = IsSegment(Primitive) ?
+				FMath::ClosestPointOnSegment(Point, Points[Verts.X], Points[Verts.Y]) :
+				FMath::ClosestPointOnTriangleToPoint(Point, Points[Verts.X], Points[Verts.Y], Points[Verts.Z]);
+
+			const double Distance = (Candidate - Point).SizeSquared();
+			if (Distance < BestDistance)
+			{
+				Best = Sources[Primitive];
+				BestDistance = Distance;
+				Closest = Candidate;
+			}
+		}
+	}
+	return Best;
+}
+
+bool FTriangleBVH::IsInside(const FVector& Point) const
+{
+	if (Nodes.Num() == 0 || !Nodes[0].Bounds.IsInsideOrOn(Point))
+	{
+		return false;
+	}
+
+	// Skewed rays out of the bounds. A ray through an edge or vertex would count one crossing on every triangle sharing it,
+	// so such rays are discarded and the next direction is tried
+	const FVector Directions[] =
+	{
+		FVector(0.5773, 0.5774, 0.5775),
+		FVector(-0.6271, 0.4142, 0.6589),
+		FVector(0.3511, -0.8029, 0.4817),
+		FVector(-0.2234, -0.5391, -0.8121),
+		FVector(0.8660, 0.1218, -0.4848)
+	};
+	const double Length = Nodes[0].Bounds.GetSize().Size() * 2.0;
+
+	int32 Crossings = 0;
+	for (const FVector& Axis : Directions)
+	{
+		const FVector Direction = Axis * Length;
+		Crossings = 0;
+		const bool Ambiguous = Traverse([&](const FBox& Bounds) { return SegmentOverlaps(Bounds, Point, Direction, 1.0); }, [&](int32 Primitive)
+		{
+			if (IsSegment(Primitive))
+			{
+				return false;
+			}
+
+			const FIntVector& Verts = Primitives[Primitive];
+			const ERayHit Hit = ClassifyRayHit(Point, Direction, Points[Verts.X], Points[Verts.Y], Points[Verts.Z]);
+			Crossings += (Hit == ERayHit::Hit) ? 1 : 0;
+			return Hit == ERayHit::Ambiguous;
+		});
+
+		if (!Ambiguous)
+		{
+			break;
+		}
+	}
+	return (Crossings % 2) == 1;
+}
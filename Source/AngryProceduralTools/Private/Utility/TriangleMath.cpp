@@ -1,4 +1,17 @@
 #include "Utility/TriangleMath.h"
+#include "Utility/GeometricPredicates.h"
+#include "Utility/Triangulation.h"
+
+namespace
+{
+	// Lanes whose determinant is this close to its cancellation error take the scalar path with exact predicates
+	constexpr double CircumcenterTolerance = 1e-12;
+
+	FORCEINLINE VectorRegister4Double VectorSetDouble(double Value)
+	{
+		return MakeVectorRegisterDouble(Value, Value, Value, Value);
+	}
+}
 
 float UTriangleMath::ProjectToBox(const FVector2D& Vector)
 {
@@ -36,18 +49,137 @@ bool UTriangleMath::ProjectToSlate(const FVector& Normal, const FVector& A, cons
 	return false;
 }
 
+void UTriangleMath::ProjectToBox(TArrayView<const double> X, TArrayView<const double> Y, TArrayView<float> Out)
+{
+	check(X.Num() == Out.Num() && Y.Num() == Out.Num());
+
+	const VectorRegister4Double Small = VectorSetDouble(SMALL_NUMBER);
+
+	const int32 Num = Out.Num();
+	const int32 VectorNum = Num - Num % 4;
+	for (int32 Base = 0; Base < VectorNum; Base += 4)
+	{
+		const VectorRegister4Double VX = VectorLoad(X.GetData() + Base);
+		const VectorRegister4Double VY = VectorLoad(Y.GetData() + Base);
+		const VectorRegister4Double XX = VectorMultiply(VX, VX);
+		const VectorRegister4Double YY = VectorMultiply(VY, VY);
+
+		// The smaller of both square roots divides by the larger square, lanes dividing by zero are replaced by the axis cases below
+		const VectorRegister4Double Ratio = VectorSqrt(VectorDivide(VectorAdd(XX, YY), VectorMax(XX, YY)));
+		const VectorRegister4Double OnY = VectorSelect(VectorCompareGT(Small, YY), VectorSqrt(XX), Ratio);
+		const VectorRegister4Double Length = VectorSelect(VectorCompareGT(Small, XX), VectorSqrt(YY), OnY);
+
+		alignas(32) double Lengths[4];
+		VectorStoreAligned(Length, Lengths);
+		for (int32 Lane = 0; Lane < 4; Lane++)
+		{
+			Out[Base + Lane] = (float)Lengths[Lane];
+		}
+	}
+
+	ProjectToBoxScalar(X.Slice(VectorNum, Num - VectorNum), Y.Slice(VectorNum, Num - VectorNum), Out.Slice(VectorNum, Num - VectorNum));
+}
+
+void UTriangleMath::ProjectToSlate(const FVector& Normal, const FVector& A, const FVector& B, const FPointsSoA& Starts, const FPointsSoA& Ends, TArrayView<bool> Out)
+{
+	check(Starts.Num() == Out.Num() && Ends.Num() == Out.Num());
+
+	// Slate is the same for every lane
+	const FVector AB = B - A;
+	const FVector Plane = (AB ^ Normal).GetSafeNormal();
+	const double Distance = AB.Size();
+	const FVector Direction = AB / Distance;
+
+	const VectorRegister4Double PlaneX = VectorSetDouble(Plane.X), PlaneY = VectorSetDouble(Plane.Y), PlaneZ = VectorSetDouble(Plane.Z);
+	const VectorRegister4Double DirectionX = VectorSetDouble(Direction.X), DirectionY = VectorSetDouble(Direction.Y), DirectionZ = VectorSetDouble(Direction.Z);
+	const VectorRegister4Double AX = VectorSetDouble(A.X), AY = VectorSetDouble(A.Y), AZ = VectorSetDouble(A.Z);
+	const VectorRegister4Double Zero = VectorSetDouble(0.0);
+	const VectorRegister4Double One = VectorSetDouble(1.0);
+	const VectorRegister4Double Small = VectorSetDouble(SMALL_NUMBER);
+	const VectorRegister4Double Length = VectorSetDouble(Distance);
+
+	const int32 Num = Out.Num();
+	const int32 VectorNum = Num - Num % 4;
+	for (int32 Base = 0; Base < VectorNum; Base += 4)
+	{
+		const VectorRegister4Double SX = VectorLoad(Starts.X.GetData() + Base);
+		const VectorRegister4Double SY = VectorLoad(Starts.Y.GetData() + Base);
+		const VectorRegister4Double SZ = VectorLoad(Starts.Z.GetData() + Base);
+		const VectorRegister4Double TSX = VectorSubtract(VectorLoad(Ends.X.GetData() + Base), SX);
+		const VectorRegister4Double TSY = VectorSubtract(VectorLoad(Ends.Y.GetData() + Base), SY);
+		const VectorRegister4Double TSZ = VectorSubtract(VectorLoad(Ends.Z.GetData() + Base), SZ);
+
+		const VectorRegister4Double ASProject = VectorAdd(VectorAdd(
+			VectorMultiply(VectorSubtract(AX, SX), PlaneX),
+			VectorMultiply(VectorSubtract(AY, SY), PlaneY)),
+			VectorMultiply(VectorSubtract(AZ, SZ), PlaneZ));
+		const VectorRegister4Double TSProject = VectorAdd(VectorAdd(
+			VectorMultiply(TSX, PlaneX),
+			VectorMultiply(TSY, PlaneY)),
+			VectorMultiply(TSZ, PlaneZ));
+
+		// Segments parallel to the slate get a ratio from dividing by zero but fail the first mask
+		const VectorRegister4Double Ratio = VectorDivide(ASProject, TSProject);
+		const VectorRegister4Double Project = VectorAdd(VectorAdd(
+			VectorMultiply(VectorSubtract(VectorAdd(SX, VectorMultiply(TSX, Ratio)), AX), DirectionX),
+			VectorMultiply(VectorSubtract(VectorAdd(SY, VectorMultiply(TSY, Ratio)), AY), DirectionY)),
+			VectorMultiply(VectorSubtract(VectorAdd(SZ, VectorMultiply(TSZ, Ratio)), AZ), DirectionZ));
+
+		const int32 Hits =
+			VectorMaskBits(VectorCompareGT(VectorMultiply(TSProject, TSProject), Small)) &
+			VectorMaskBits(VectorCompareGE(Ratio, Zero)) & VectorMaskBits(VectorCompareLE(Ratio, One)) &
+			VectorMaskBits(VectorCompareGE(Project, Zero)) & VectorMaskBits(VectorCompareLE(Project, Length));
+
+		for (int32 Lane = 0; Lane < 4; Lane++)
+		{
+			Out[Base + Lane] = (Hits & (1 << Lane)) != 0;
+		}
+	}
+
+	const FPointsSoA StartsTail = { Starts.X.Slice(VectorNum, Num - VectorNum), Starts.Y.Slice(VectorNum, Num - VectorNum), Starts.Z.Slice(VectorNum, Num - VectorNum) };
+	const FPointsSoA EndsTail = { Ends.X.Slice(VectorNum, Num - VectorNum), Ends.Y.Slice(VectorNum, Num - VectorNum), Ends.Z.Slice(VectorNum, Num - VectorNum) };
+	ProjectToSlateScalar(Normal, A, B, StartsTail, EndsTail, Out.Slice(VectorNum, Num - VectorNum));
+}
+
+void UTriangleMath::ProjectToBoxScalar(TArrayView<const double> X, TArrayView<const double> Y, TArrayView<float> Out)
+{
+	check(X.Num() == Out.Num() && Y.Num() == Out.Num());
+
+	for (int32 Index = 0; Index < Out.Num(); Index++)
+	{
+		Out[Index] = ProjectToBox(FVector2D(X[Index], Y[Index]));
+	}
+}
+
+void UTriangleMath::ProjectToSlateScalar(const FVector& Normal, const FVector& A, const FVector& B, const FPointsSoA& Starts, const FPointsSoA& Ends, TArrayView<bool> Out)
+{
+	check(Starts.Num() == Out.Num() && Ends.Num() == Out.Num());
+
+	for (int32 Index = 0; Index < Out.Num(); Index++)
+	{
+		Out[Index] = ProjectToSlate(Normal, A, B, FVector(Starts.X[Index], Starts.Y[Index], Starts.Z[Index]), FVector(Ends.X[Index], Ends.Y[Index], Ends.Z[Index]));
+	}
+}
+
 bool UTriangleMath::ComputeCircumcenter(const FVector& A, const FVector& B, const FVector& C, FVector& Out)
 {
-	const float aa = (B - C).SizeSquared();
-	const float bb = (C - A).SizeSquared();
-	const float cc = (A - B).SizeSquared();
+	// Exact test so tiny triangles aren't mistaken for degenerate ones
+	if (FGeometricPredicates::IsCollinear(A, B, C))
+	{
+		Out = (A + B + C) / 3;
+		return false;
+	}
+
+	const double aa = (B - C).SizeSquared();
+	const double bb = (C - A).SizeSquared();
+	const double cc = (A - B).SizeSquared();
 
-	const float wa = (aa * (bb + cc - aa));
-	const float wb = (bb * (cc + aa - bb));
-	const float wc = (cc * (aa + bb - cc));
-	const float w = wa + wb + wc;
+	const double wa = (aa * (bb + cc - aa));
+	const double wb = (bb * (cc + aa - bb));
+	const double wc = (cc * (aa + bb - cc));
+	const double w = wa + wb + wc;
 
-	if (FMath::Abs(w) < SMALL_NUMBER)
+	if (w == 0.0)
 	{
 		Out = (A + B + C) / 3;
 		return false;
@@ -59,21 +191,209 @@ bool UTriangleMath::ComputeCircumcenter(const FVector& A, const FVector& B, cons
 
 bool UTriangleMath::ComputeCircumcenter2D(const FVector2D& A, const FVector2D& B, const FVector2D& C, FVector2D& Out)
 {
-	const float aa = (B - C).SizeSquared();
-	const float bb = (C - A).SizeSquared();
-	const float cc = (A - B).SizeSquared();
-
-	const float wa = (aa * (bb + cc - aa));
-	const float wb = (bb * (cc + aa - bb));
-	const float wc = (cc * (aa + bb - cc));
-	const float w = wa + wb + wc;
-
-	if (FMath::Abs(w) < SMALL_NUMBER)
+	const double Det = FGeometricPredicates::Orient2D(A, B, C);
+	if (Det == 0.0)
 	{
 		Out = (A + B + C) / 3;
 		return false;
 	}
 
-	Out = (wa * A + wb * B + wc * C) / w;
+	// Relative to A to keep precision for triangles far from the origin
+	const FVector2D AB = B - A;
+	const FVector2D AC = C - A;
+	const double ABSize = AB.SizeSquared();
+	const double ACSize = AC.SizeSquared();
+	Out = A + FVector2D(AC.Y * ABSize - AB.Y * ACSize, AB.X * ACSize - AC.X * ABSize) / (2.0 * Det);
 	return true;
-}
\ No newline at end of file
+}
+
+void UTriangleMath::ComputeCircumcenters(TArrayView<const FVector> Points, TArrayView<const FGenTriangle> Triangles, TArrayView<FVector> Centers, TArrayView<double> Radii)
+{
+	check(Triangles.Num() == Centers.Num() && Triangles.Num() == Radii.Num());
+
+	const VectorRegister4Double Tolerance = VectorSetDouble(CircumcenterTolerance);
+
+	const int32 Num = Triangles.Num();
+	const int32 VectorNum = Num - Num % 4;
+	for (int32 Base = 0; Base < VectorNum; Base += 4)
+	{
+		// Structure of arrays per batch, free slots read the first point and get overwritten below
+		alignas(32) double Coords[9][4];
+		for (int32 Lane = 0; Lane < 4; Lane++)
+		{
+			const FGenTriangle& Triangle = Triangles[Base + Lane];
+			for (int32 Vert = 0; Vert < 3; Vert++)
+			{
+				const FVector& Point = Points[FMath::Max(Triangle.Verts[Vert], 0)];
+				Coords[Vert * 3 + 0][Lane] = Point.X;
+				Coords[Vert * 3 + 1][Lane] = Point.Y;
+				Coords[Vert * 3 + 2][Lane] = Point.Z;
+			}
+		}
+
+		VectorRegister4Double Corners[9];
+		for (int32 Coord = 0; Coord < 9; Coord++)
+		{
+			Corners[Coord] = VectorLoadAligned(Coords[Coord]);
+		}
+
+		// Barycentric weights from squared side lengths, same as the scalar version
+		VectorRegister4Double Sides[3];
+		for (int32 Side = 0; Side < 3; Side++)
+		{
+			const int32 From = ((Side + 1) % 3) * 3;
+			const int32 To = ((Side + 2) % 3) * 3;
+			const VectorRegister4Double X = VectorSubtract(Corners[From + 0], Corners[To + 0]);
+			const VectorRegister4Double Y = VectorSubtract(Corners[From + 1], Corners[To + 1]);
+			const VectorRegister4Double Z = VectorSubtract(Corners[From + 2], Corners[To + 2]);
+			Sides[Side] = VectorAdd(VectorAdd(VectorMultiply(X, X), VectorMultiply(Y, Y)), VectorMultiply(Z, Z));
+		}
+
+		VectorRegister4Double Weights[3];
+		for (int32 Side = 0; Side < 3; Side++)
+		{
+			Weights[Side] = VectorMultiply(Sides[Side], VectorSubtract(VectorAdd(Sides[(Side + 1) % 3], Sides[(Side + 2) % 3]), Sides[Side]));
+		}
+		const VectorRegister4Double Sum = VectorAdd(VectorAdd(Weights[0], Weights[1]), Weights[2]);
+		const VectorRegister4Double Magnitude = VectorAdd(VectorAdd(VectorAbs(Weights[0]), VectorAbs(Weights[1])), VectorAbs(Weights[2]));
+		const int32 Scalar = VectorMaskBits(VectorCompareLE(VectorAbs(Sum), VectorMultiply(Tolerance, Magnitude)));
+
+		alignas(32) double Out[4][4];
+		for (int32 Axis = 0; Axis < 3; Axis++)
+		{
+			const VectorRegister4Double Weighted = VectorAdd(VectorAdd(
+				VectorMultiply(Weights[0], Corners[Axis]),
+				VectorMultiply(Weights[1], Corners[3 + Axis])),
+				VectorMultiply(Weights[2], Corners[6 + Axis]));
+			VectorStoreAligned(VectorDivide(Weighted, Sum), Out[Axis]);
+		}
+
+		for (int32 Lane = 0; Lane < 4; Lane++)
+		{
+			const int32 Index = Base + Lane;
+			const FGenTriangle& Triangle = Triangles[Index];
+			if (Triangle.Verts[0] == INDEX_NONE)
+			{
+				Centers[Index] = FVector::ZeroVector;
+				Radii[Index] = 0.0;
+			}
+			else if (Scalar & (1 << Lane))
+			{
+				ComputeCircumcentersScalar(Points, Triangles.Slice(Index, 1), Centers.Slice(Index, 1), Radii.Slice(Index, 1));
+			}
+			else
+			{
+				Centers[Index] = FVector(Out[0][Lane], Out[1][Lane], Out[2][Lane]);
+				Radii[Index] = (Centers[Index] - Points[Triangle.Verts[0]]).SizeSquared();
+			}
+		}
+	}
+
+	ComputeCircumcentersScalar(Points, Triangles.Slice(VectorNum, Num - VectorNum), Centers.Slice(VectorNum, Num - VectorNum), Radii.Slice(VectorNum, Num - VectorNum));
+}
+
+void UTriangleMath::ComputeCircumcenters2D(TArrayView<const FVector2D> Points, TArrayView<const FGenTriangle> Triangles, TArrayView<FVector2D> Centers, TArrayView<double> Radii)
+{
+	check(Triangles.Num() == Centers.Num() && Triangles.Num() == Radii.Num());
+
+	const VectorRegister4Double Tolerance = VectorSetDouble(CircumcenterTolerance);
+	const VectorRegister4Double Half = VectorSetDouble(0.5);
+
+	const int32 Num = Triangles.Num();
+	const int32 VectorNum = Num - Num % 4;
+	for (int32 Base = 0; Base < VectorNum; Base += 4)
+	{
+		// Edges relative to the first vertex like the scalar version, keeps precision far from the origin
+		alignas(32) double ABX[4], ABY[4], ACX[4], ACY[4];
+		for (int32 Lane = 0; Lane < 4; Lane++)
+		{
+			const FGenTriangle& Triangle = Triangles[Base + Lane];
+			const FVector2D& A = Points[FMath::Max(Triangle.Verts[0], 0)];
+			const FVector2D& B = Points[FMath::Max(Triangle.Verts[1], 0)];
+			const FVector2D& C = Points[FMath::Max(Triangle.Verts[2], 0)];
+			ABX[Lane] = B.X - A.X; ABY[Lane] = B.Y - A.Y;
+			ACX[Lane] = C.X - A.X; ACY[Lane] = C.Y - A.Y;
+		}
+
+		const VectorRegister4Double BX = VectorLoadAligned(ABX), BY = VectorLoadAligned(ABY);
+		const VectorRegister4Double CX = VectorLoadAligned(ACX), CY = VectorLoadAligned(ACY);
+		const VectorRegister4Double BSize = VectorAdd(VectorMultiply(BX, BX), VectorMultiply(BY, BY));
+		const VectorRegister4Double CSize = VectorAdd(VectorMultiply(CX, CX), VectorMultiply(CY, CY));
+
+		const VectorRegister4Double Left = VectorMultiply(BX, CY);
+		const VectorRegister4Double Right = VectorMultiply(BY, CX);
+		const VectorRegister4Double Det = VectorSubtract(Left, Right);
+		const int32 Scalar = VectorMaskBits(VectorCompareLE(VectorAbs(Det), VectorMultiply(Tolerance, VectorAdd(VectorAbs(Left), VectorAbs(Right)))));
+
+		const VectorRegister4Double Scale = VectorDivide(Half, Det);
+		const VectorRegister4Double X = VectorMultiply(VectorSubtract(VectorMultiply(CY, BSize), VectorMultiply(BY, CSize)), Scale);
+		const VectorRegister4Double Y = VectorMultiply(VectorSubtract(VectorMultiply(BX, CSize), VectorMultiply(CX, BSize)), Scale);
+
+		alignas(32) double OffsetX[4], OffsetY[4], Radius[4];
+		VectorStoreAligned(X, OffsetX);
+		VectorStoreAligned(Y, OffsetY);
+		VectorStoreAligned(VectorAdd(VectorMultiply(X, X), VectorMultiply(Y, Y)), Radius);
+
+		for (int32 Lane = 0; Lane < 4; Lane++)
+		{
+			const int32 Index = Base + Lane;
+			const FGenTriangle& Triangle = Triangles[Index];
+			if (Triangle.Verts[0] == INDEX_NONE)
+			{
+				Centers[Index] = FVector2D::ZeroVector;
+				Radii[Index] = 0.0;
+			}
+			else if (Scalar & (1 << Lane))
+			{
+				ComputeCircumcenters2DScalar(Points, Triangles.Slice(Index, 1), Centers.Slice(Index, 1), Radii.Slice(Index, 1));
+			}
+			else
+			{
+				Centers[Index] = Points[Triangle.Verts[0]] + FVector2D(OffsetX[Lane], OffsetY[Lane]);
+				Radii[Index] = Radius[Lane];
+			}
+		}
+	}
+
+	ComputeCircumcenters2DScalar(Points, Triangles.Slice(VectorNum, Num - VectorNum), Centers.Slice(VectorNum, Num - VectorNum), Radii.Slice(VectorNum, Num - VectorNum));
+}
+
+void UTriangleMath::ComputeCircumcentersScalar(TArrayView<const FVector> Points, TArrayView<const FGenTriangle> Triangles, TArrayView<FVector> Centers, TArrayView<double> Radii)
+{
+	check(Triangles.Num() == Centers.Num() && Triangles.Num() == Radii.Num());
+
+	for (int32 Index = 0; Index < Triangles.Num(); Index++)
+	{
+		const FGenTriangle& Triangle = Triangles[Index];
+		if (Triangle.Verts[0] == INDEX_NONE)
+		{
+			Centers[Index] = FVector::ZeroVector;
+			Radii[Index] = 0.0;
+			continue;
+		}
+
+		const FVector& A = Points[Triangle.Verts[0]];
+		ComputeCircumcenter(A, Points[Triangle.Verts[1]], Points[Triangle.Verts[2]], Centers[Index]);
+		Radii[Index] = (Centers[Index] - A).SizeSquared();
+	}
+}
+
+void UTriangleMath::ComputeCircumcenters2DScalar(TArrayView<const FVector2D> Points, TArrayView<const FGenTriangle> Triangles, TArrayView<FVector2D> Centers, TArrayView<double> Radii)
+{
+	check(Triangles.Num() == Centers.Num() && Triangles.Num() == Radii.Num());
+
+	for (int32 Index = 0; Index < Triangles.Num(); Index++)
+	{
+		const FGenTriangle& Triangle = Triangles[Index];
+		if (Triangle.Verts[0] == INDEX_NONE)
+		{
+			Centers[Index] = FVector2D::ZeroVector;
+			Radii[Index] = 0.0;
+			continue;
+		}
+
+		const FVector2D& A = Points[Triangle.Verts[0]];
+		ComputeCircumcenter2D(A, Points[Triangle.Verts[1]], Points[Triangle.Verts[2]], Centers[Index]);
+		Radii[Index] = (Centers[Index] - A).SizeSquared();
+	}
+}
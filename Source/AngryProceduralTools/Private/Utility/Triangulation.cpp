@@ -1,6 +1,102 @@
 #include "Utility/Triangulation.h"
+#include "AngryProceduralTools.h"
 #include "Utility/TriangleMath.h"
+#include "Utility/GeometricPredicates.h"
+#include "TriangulationStats.h"
 #include "DrawDebugHelpers.h"
+#include "Algo/Sort.h"
+#include "Async/ParallelFor.h"
+#include "Serialization/CustomVersion.h"
+
+DEFINE_STAT(STAT_AngryTriangulation_Flips);
+DEFINE_STAT(STAT_AngryTriangulation_CircleTests);
+DEFINE_STAT(STAT_AngryTriangulation_LocateSteps);
+DEFINE_STAT(STAT_AngryTriangulation_LocateFallbacks);
+DEFINE_STAT(STAT_AngryTriangulation_CapHits);
+DEFINE_STAT(STAT_AngryTriangulation_ExactPredicates);
+
+namespace
+{
+	// Monotonic stand-in for the angle of a direction in [0, 1], cheaper than atan2
+	FORCEINLINE double PseudoAngle(const FVector2D& Delta)
+	{
+		const double Sum = FMath::Abs(Delta.X) + FMath::Abs(Delta.Y);
+		const double Ratio = (Sum > 0.0) ? (Delta.X / Sum) : 0.0;
+		return (Delta.Y > 0.0 ? 3.0 - Ratio : 1.0 + Ratio) / 4.0;
+	}
+
+	// Whether D lies strictly inside the circumcircle of clockwise triangle ABC
+	FORCEINLINE bool InsideCircumcircle(const FVector2D& A, const FVector2D& B, const FVector2D& C, const FVector2D& D)
+	{
+		return FGeometricPredicates::InCirclePerturbed(A, B, C, D) < 0.0;
+	}
+
+	// Order independent key of an edge between two vertices
+	FORCEINLINE uint64 MakeEdgeKey(int32 A, int32 B)
+	{
+		return ((uint64)(uint32)FMath::Min(A, B) << 32) | (uint64)(uint32)FMath::Max(A, B);
+	}
+
+	// Position along a Hilbert curve of given order for grid coordinates
+	uint64 HilbertIndex(uint32 X, uint32 Y, int32 Order)
+	{
+		uint64 Index = 0;
+		for (uint32 Side = 1u << (Order - 1); Side > 0; Side >>= 1)
+		{
+			const uint32 RX = (X & Side) ? 1 : 0;
+			const uint32 RY = (Y & Side) ? 1 : 0;
+			Index += (uint64)Side * Side * ((3 * RX) ^ RY);
+
+			// Rotate quadrant
+			if (RY == 0)
+			{
+				if (RX == 1)
+				{
+					X = Side - 1 - (X & (Side - 1));
+					Y = Side - 1 - (Y & (Side - 1));
+				}
+				Swap(X, Y);
+			}
+		}
+		return Index;
+	}
+
+	// Maps small signed deltas to small unsigned numbers so they pack into few bytes
+	FORCEINLINE uint32 ZigZag(int32 Value)
+	{
+		return ((uint32)Value << 1) ^ (uint32)(Value >> 31);
+	}
+
+	FORCEINLINE int32 UnZigZag(uint32 Value)
+	{
+		return (int32)(Value >> 1) ^ -(int32)(Value & 1);
+	}
+
+	// Binary layout of serialized triangulations, add an entry before VersionPlusOne whenever it changes
+	struct FTriangulationVersion
+	{
+		enum Type
+		{
+			Initial = 0,
+
+			VersionPlusOne,
+			LatestVersion = VersionPlusOne - 1
+		};
+
+		static const FGuid GUID;
+	};
+
+	const FGuid FTriangulationVersion::GUID(0x6E0B4D27, 0x31A84C9F, 0x8D52F1E3, 0xB7406A19);
+	FCustomVersionRegistration GRegisterTriangulationVersion(FTriangulationVersion::GUID, FTriangulationVersion::LatestVersion, TEXT("AngryTriangulationVer"));
+
+	// Packages saved before the binary layout hold tagged properties, returning false lets the engine read those instead.
+	// Transient archives like undo buffers are read by the build that wrote them and often carry no versions at all
+	bool HasBinaryLayout(FArchive& Ar)
+	{
+		Ar.UsingCustomVersion(FTriangulationVersion::GUID);
+		return !Ar.IsPersistent() || Ar.CustomVer(FTriangulationVersion::GUID) >= FTriangulationVersion::Initial;
+	}
+}
 
 FGenTriangleEdge::FGenTriangleEdge()
 : T(INDEX_NONE), E(INDEX_NONE)
@@ -74,6 +170,11 @@ bool FGenTriangle::HasVertex(int32 Vertex) const
 	return Verts[0] == Vertex || Verts[1] == Vertex || Verts[2] == Vertex;
 }
 
+bool FGenTriangle::IsFreeSlot() const
+{
+	return Verts[0] == INDEX_NONE;
+}
+
 void FGenTriangle::ReplaceAdj(int32 From, int32 To)
 {
 	for (int32& Adj : Adjs)
@@ -117,6 +218,8 @@ bool FGenTriangle::IsConnected(const FGenTriangle& Other) const
 
 void FTriangulation::Reparent(const TArray<int32>& TriangleIndices)
 {
+	ANGRY_TRIANGULATION_SCOPE(Reparent);
+
 	// Gather all parents and reset input triangles
 	TArray<int32> Neighbours;
 	for (int32 TriangleIndex : TriangleIndices)
@@ -145,9 +248,240 @@ void FTriangulation::Reparent(const TArray<int32>& TriangleIndices)
 	}
 }
 
+void FTriangulation::ReparentAll()
+{
+	BuildAdjacency();
+}
+
+int32 FTriangulation::BuildAdjacency()
+{
+	const int32 Num = Triangles.Num();
+
+	// Map every directed edge to its triangle edge
+	TMap<uint64, int32> HalfEdges;
+	HalfEdges.Reserve(Num * 3);
+
+	int32 NonManifold = 0;
+	for (int32 Index = 0; Index < Num; Index++)
+	{
+		FGenTriangle& Triangle = Triangles[Index];
+		Triangle.ClearAdjs();
+
+		for (int32 Edge = 0; Edge < 3; Edge++)
+		{
+			const uint64 Key = ((uint64)(uint32)Triangle.Verts[(Edge + 1) % 3] << 32) | (uint32)Triangle.Verts[(Edge + 2) % 3];
+			if (int32* Existing = HalfEdges.Find(Key))
+			{
+				// Same directed edge twice means more than two triangles share it or the winding flips, none of them get linked across it
+				if (*Existing != INDEX_NONE)
+				{
+					NonManifold++;
+					*Existing = INDEX_NONE;
+				}
+			}
+			else
+			{
+				HalfEdges.Add(Key, Index * 3 + Edge);
+			}
+		}
+	}
+
+	// Link each directed edge to its reverse, degenerate edges repeating a vertex are their own reverse and stay unlinked
+	for (const TPair<uint64, int32>& Pair : HalfEdges)
+	{
+		const uint64 Twin = (Pair.Key << 32) | (Pair.Key >> 32);
+		const int32* Other = HalfEdges.Find(Twin);
+		if (Pair.Value != INDEX_NONE && Other && *Other != INDEX_NONE && *Other / 3 != Pair.Value / 3)
+		{
+			Triangles[Pair.Value / 3].Adjs[Pair.Value % 3] = *Other / 3;
+		}
+	}
+	return NonManifold;
+}
+
+int32 FTriangulation::FlipEdge(int32 Index, int32 Edge)
+{
+	const int32 Adj = Triangles[Index].Adjs[Edge];
+	if (!Triangles.IsValidIndex(Adj))
+	{
+		return INDEX_NONE;
+	}
+
+	FGenTriangle& Mine = Triangles[Index];
+	FGenTriangle& Your = Triangles[Adj];
+
+	const int32 YourEdge = Your.OppositeOf(Mine);
+	if (YourEdge == INDEX_NONE)
+	{
+		return INDEX_NONE;
+	}
+
+	const int32 MineNext = (Edge + 1) % 3;
+	Mine.Verts[MineNext] = Your.Verts[YourEdge];
+
+	const int32 YourNext = (YourEdge + 1) % 3;
+	Your.Verts[YourNext] = Mine.Verts[Edge];
+
+	const int32 MinePrev = (Edge + 2) % 3;
+	Your.Adjs[YourEdge] = Mine.Adjs[MinePrev];
+	Mine.Adjs[MinePrev] = Adj;
+
+	const int32 YourPrev = (YourEdge + 2) % 3;
+	Mine.Adjs[Edge] = Your.Adjs[YourPrev];
+	Your.Adjs[YourPrev] = Index;
+
+	// Relink outer neighbours that switched triangles
+	if (Triangles.IsValidIndex(Mine.Adjs[Edge]))
+	{
+		Triangles[Mine.Adjs[Edge]].ReplaceAdj(Adj, Index);
+	}
+
+	if (Triangles.IsValidIndex(Your.Adjs[YourEdge]))
+	{
+		Triangles[Your.Adjs[YourEdge]].ReplaceAdj(Index, Adj);
+	}
+	return YourEdge;
+}
+
+
+bool FTriangulation::IsVertexConnected(int32 Index, int32 Vert, int32 Other) const
+{
+	// Rotate around the vertex in both directions until we hit a border or come back around
+	const int32 Vertex = Triangles[Index].Verts[Vert];
+	for (int32 Direction = 1; Direction <= 2; Direction++)
+	{
+		int32 Current = Index;
+		int32 Prev = INDEX_NONE;
+		for (int32 Step = 0; Step < Triangles.Num(); Step++)
+		{
+			const FGenTriangle& Triangle = Triangles[Current];
+			if (Triangle.HasVertex(Other))
+			{
+				return true;
+			}
+
+			// Edge opposite to the next vertex in rotation direction, skip the one we came from
+			int32 Next = INDEX_NONE;
+			for (int32 Edge = 0; Edge < 3; Edge++)
+			{
+				const int32 Adj = Triangle.Adjs[Edge];
+				if (Triangle.Verts[Edge] != Vertex && Adj != Prev && (Prev != INDEX_NONE || Edge == (Vert + Direction) % 3))
+				{
+					Next = Adj;
+					break;
+				}
+			}
+
+			if (!Triangles.IsValidIndex(Next) || Next == Index)
+			{
+				break;
+			}
+			Prev = Current;
+			Current = Next;
+		}
+	}
+	return false;
+}
+
+bool FTriangulation::SerializeTriangles(FArchive& Ar)
+{
+	int32 Num = Triangles.Num();
+	Ar << Num;
+	if (Ar.IsLoading())
+	{
+		// Every triangle takes at least six packed bytes, larger counts can only come from corrupt data
+		const int64 Remaining = Ar.TotalSize() - Ar.Tell();
+		if (Num < 0 || (Ar.TotalSize() > 0 && (int64)Num * 6 > Remaining))
+		{
+			Ar.SetError();
+			Triangles.Reset();
+			return false;
+		}
+		Triangles.Reset(Num);
+		Triangles.SetNum(Num);
+	}
+
+	TBitArray<> Enabled(false, Num);
+	for (int32 Index = 0; Index < Num && Ar.IsSaving(); Index++)
+	{
+		Enabled[Index] = Triangles[Index].Enabled;
+	}
+	Ar << Enabled;
+	if (Enabled.Num() != Num || Ar.IsError())
+	{
+		Ar.SetError();
+		Triangles.Reset();
+		return false;
+	}
+
+	// Same code reads and writes, loading overwrites each field with what was read
+	int32 Previous = 0;
+	for (int32 Index = 0; Index < Num; Index++)
+	{
+		FGenTriangle& Triangle = Triangles[Index];
+
+		// Vertices of consecutive triangles are close, deltas to the previous vertex mostly fit a byte
+		for (int32 Slot = 0; Slot < 3; Slot++)
+		{
+			uint32 Packed = ZigZag(Triangle.Verts[Slot] - Previous);
+			Ar.SerializeIntPacked(Packed);
+			Triangle.Verts[Slot] = Previous + UnZigZag(Packed);
+			Previous = Triangle.Verts[Slot];
+		}
+
+		// Neighbours relative to the triangle itself, zero is the border
+		for (int32 Edge = 0; Edge < 3; Edge++)
+		{
+			uint32 Packed = (Triangle.Adjs[Edge] == INDEX_NONE) ? 0 : ZigZag(Triangle.Adjs[Edge] - Index) + 1;
+			Ar.SerializeIntPacked(Packed);
+			Triangle.Adjs[Edge] = (Packed == 0) ? INDEX_NONE : Index + UnZigZag(Packed - 1);
+		}
+
+		Triangle.Enabled = Enabled[Index];
+	}
+	return !Ar.IsError();
+}
+
+bool FTriangulation::HasValidIndices(int32 PointNum) const
+{
+	const int32 Num = Triangles.Num();
+	for (const FGenTriangle& Triangle : Triangles)
+	{
+		if (Triangle.IsFreeSlot())
+		{
+			continue;
+		}
+
+		for (int32 Slot = 0; Slot < 3; Slot++)
+		{
+			if (Triangle.Verts[Slot] < 0 || Triangle.Verts[Slot] >= PointNum || Triangle.Adjs[Slot] < INDEX_NONE || Triangle.Adjs[Slot] >= Num)
+			{
+				return false;
+			}
+		}
+	}
+	return true;
+}
 
+bool FTriangulation3D::Serialize(FArchive& Ar)
+{
+	if (!HasBinaryLayout(Ar))
+	{
+		return false;
+	}
 
+	const bool Valid = SerializeTriangles(Ar);
+	Ar << Points;
 
+	// Nothing may walk indices that point outside of the buffers
+	if (Ar.IsLoading() && (!Valid || Ar.IsError() || !HasValidIndices(Points.Num())))
+	{
+		Ar.SetError();
+		Triangles.Reset();
+		Points.Reset();
+	}
+	return true;
+}
 
 void FTriangulation3D::DrawTriangles(UWorld* World, const FTransform& Transform)
 {
@@ -189,7 +523,7 @@ void FTriangulation3D::DrawTriangles(UWorld* World, const FTransform& Transform)
 	}
 }
 
-void FTriangulation3D::Circumcenter(int32 Index, FVector& Center, float& Radius) const
+void FTriangulation3D::Circumcenter(int32 Index, FVector& Center, double& Radius) const
 {
 	const FGenTriangle& Triangle = Triangles[Index];
 
@@ -201,61 +535,136 @@ void FTriangulation3D::Circumcenter(int32 Index, FVector& Center, float& Radius)
 		Radius = (Center - A).SizeSquared();
 		return;
 	}
-	Radius = 0.0f;
+	Radius = 0.0;
 }
 
 bool FTriangulation3D::FixTriangles(int32 MaxIterations)
 {
+	FTriangulationScratch Scratch;
+	return FixTriangles(MaxIterations, Scratch);
+}
+
+template<typename AllocatorType>
+bool FTriangulation3D::FixTriangles(int32 MaxIterations, TTriangulationScratch<AllocatorType>& Scratch)
+{
+	ANGRY_TRIANGULATION_SCOPE(FixTriangles3D);
+
 	const int32 Total = Triangles.Num();
 	const int32 Iterations = (MaxIterations < 0) ? Total : MaxIterations;
-	for (int32 Iteration = 0; Iteration < Iterations; Iteration++)
+
+	// Cache triangle circumcircles, all at once in batches and then one by one after flips
+	TArray<FVector, AllocatorType>& Centers = Scratch.Centers;
+	Centers.SetNumUninitialized(Total, false);
+
+	TArray<double, AllocatorType>& Radius = Scratch.Radius;
+	Radius.SetNumUninitialized(Total, false);
+	UTriangleMath::ComputeCircumcenters(Points, Triangles, Centers, Radius);
+
+	const auto CacheCircumcenter = [&](int32 Index)
 	{
-		bool Changed = false;
-		for (int32 Index = 0; Index < Total; Index++)
+		const FGenTriangle& Triangle = Triangles[Index];
+		const FVector A = Points[Triangle.Verts[0]];
+		UTriangleMath::ComputeCircumcenter(A, Points[Triangle.Verts[1]], Points[Triangle.Verts[2]], Centers[Index]);
+		Radius[Index] = (Centers[Index] - A).SizeSquared();
+	};
+
+	// Every edge is checked from both sides, flags avoid queueing the same edge twice
+	TArray<FGenTriangleEdge, AllocatorType>& Dirty = Scratch.Dirty;
+	Dirty.Reset(Total * 3);
+	TBitArray<TInlineAllocator<4, AllocatorType>>& Queued = Scratch.Queued;
+	Queued.Init(false, Total * 3);
+	const auto Enqueue = [&](int32 Index, int32 Edge)
+	{
+		if (Edge != INDEX_NONE && !Queued[Index * 3 + Edge])
 		{
-			FGenTriangle& Mine = Triangles[Index];
-
-			const FVector A = Points[Mine.Verts[0]];
-			const FVector B = Points[Mine.Verts[1]];
-			const FVector C = Points[Mine.Verts[2]];
-			FVector Circ;
-			UTriangleMath::ComputeCircumcenter(A, B, C, Circ);
-			const float RR = (Circ - A).SizeSquared();
+			Queued[Index * 3 + Edge] = true;
+			Dirty.Emplace(FGenTriangleEdge(Index, Edge));
+		}
+	};
 
-			for (int32 Adj : Mine.Adjs)
+	for (int32 Index = Total - 1; Index >= 0; Index--)
+	{
+		for (int32 Edge = 2; Edge >= 0; Edge--)
+		{
+			if (Triangles.IsValidIndex(Triangles[Index].Adjs[Edge]))
 			{
-				if (Triangles.IsValidIndex(Adj))
-				{
-					FGenTriangle& Your = Triangles[Adj];
+				Enqueue(Index, Edge);
+			}
+		}
+	}
 
-					const int32 MineOpps = Mine.OppositeOf(Your);
-					const int32 YourOpps = Your.OppositeOf(Mine);
-					if (MineOpps != INDEX_NONE && YourOpps != INDEX_NONE)
-					{
-						const FVector D = Points[Your.Verts[YourOpps]];
-						if ((Circ - D).SizeSquared() < RR)
-						{
-							const int32 MineNext = (MineOpps + 1) % 3;
-							Mine.Verts[MineNext] = Your.Verts[YourOpps];
+	// Flip edges until no edge is dirty or we run out of budget
+	FTriangulationCounters Work;
+	int64 Budget = (int64)Iterations * Total;
+	while (Dirty.Num() > 0)
+	{
+		const FGenTriangleEdge Edge = Dirty.Pop(false);
+		Queued[Edge.T * 3 + Edge.E] = false;
+
+		const FGenTriangle& Mine = Triangles[Edge.T];
+		const int32 Adj = Mine.Adjs[Edge.E];
+		if (!Triangles.IsValidIndex(Adj)) continue;
+
+		const FGenTriangle& Your = Triangles[Adj];
+		const int32 YourOpps = Your.OppositeOf(Mine);
+		if (YourOpps == INDEX_NONE) continue;
+
+		// Check whether inside circumcircle
+		const FVector D = Points[Your.Verts[YourOpps]];
+		Work.CircleTests++;
+		if ((Centers[Edge.T] - D).SizeSquared() >= Radius[Edge.T]) continue;
+
+		// Only flip convex quads so neither new triangle folds over relative to the old one
+		const FVector A = Points[Mine.Verts[Edge.E]];
+		const FVector B = Points[Mine.Verts[(Edge.E + 1) % 3]];
+		const FVector C = Points[Mine.Verts[(Edge.E + 2) % 3]];
+		const FVector Normal = (B - A) ^ (C - A);
+		if (FGeometricPredicates::Orient3D(A, D, C, A + Normal) >= 0.0 || FGeometricPredicates::Orient3D(D, A, B, D + Normal) >= 0.0) continue;
+
+		// On curved surfaces the flipped pair can prefer the old diagonal again, don't flip back and forth
+		FVector MineCenter, YourCenter;
+		UTriangleMath::ComputeCircumcenter(A, D, C, MineCenter);
+		UTriangleMath::ComputeCircumcenter(D, A, B, YourCenter);
+		if ((MineCenter - B).SizeSquared() < (MineCenter - A).SizeSquared() || (YourCenter - C).SizeSquared() < (YourCenter - A).SizeSquared()) continue;
+
+		// On curved surfaces the new diagonal might already exist elsewhere
+		if (IsVertexConnected(Edge.T, Edge.E, Your.Verts[YourOpps])) continue;
+
+		if (Budget-- <= 0)
+		{
+			Work.CapHits++;
+			PublishTriangulationCounters(Counters, Work);
+			Scratch.UpdatePeak();
+			return false;
+		}
 
-							const int32 YourNext = (YourOpps + 1) % 3;
-							Your.Verts[YourNext] = Mine.Verts[MineOpps];
+		const int32 YourEdge = FlipEdge(Edge.T, Edge.E);
+		if (YourEdge == INDEX_NONE) continue;
+		Work.Flips++;
 
-							Reparent({ Index, Adj });
-							Changed = true;
-							break;
-						}
-					}
-				}
+		CacheCircumcenter(Edge.T);
+		CacheCircumcenter(Adj);
+
+		// Outer edges of both triangles are dirty from either side
+		const int32 Quad[4][2] = { { Edge.T, Edge.E }, { Edge.T, (Edge.E + 1) % 3 }, { Adj, YourEdge }, { Adj, (YourEdge + 1) % 3 } };
+		for (const int32(&Side)[2] : Quad)
+		{
+			const int32 Outer = Triangles[Side[0]].Adjs[Side[1]];
+			if (Triangles.IsValidIndex(Outer))
+			{
+				Enqueue(Side[0], Side[1]);
+				Enqueue(Outer, Triangles[Outer].OppositeOf(Triangles[Side[0]]));
 			}
 		}
-
-		// No need to keep going if nothing changed
-		if (!Changed) break;
 	}
+	PublishTriangulationCounters(Counters, Work);
+	Scratch.UpdatePeak();
 	return true;
 }
 
+template ANGRYPROCEDURALTOOLS_API bool FTriangulation3D::FixTriangles<FDefaultAllocator>(int32 MaxIterations, FTriangulationScratch& Scratch);
+template ANGRYPROCEDURALTOOLS_API bool FTriangulation3D::FixTriangles<TMemStackAllocator<>>(int32 MaxIterations, FTriangulationMemStackScratch& Scratch);
+
 
 FVector FTriangulation2D::ComputeArea(const FGenTriangle& Triangle) const
 {
@@ -283,7 +692,7 @@ FVector FTriangulation2D::InsideCheck(const FGenTriangle& Triangle, const FVecto
 	return	Out;
 }
 
-void FTriangulation2D::Circumcenter(int32 Index, FVector2D& Center, float& Radius) const
+void FTriangulation2D::Circumcenter(int32 Index, FVector2D& Center, double& Radius) const
 {
 	const FGenTriangle& Triangle = Triangles[Index];
 
@@ -295,108 +704,74 @@ void FTriangulation2D::Circumcenter(int32 Index, FVector2D& Center, float& Radiu
 		Radius = (Center - A).SizeSquared();
 		return;
 	}
-	Radius = 0.0f;
+	Radius = 0.0;
 }
 
 
 bool FTriangulation2D::FixTriangles(int32 MaxIterations)
 {
-	const int32 Total = Triangles.Num();
-
-	TArray<FVector2D> Centers;
-	Centers.SetNum(Total);
+	FTriangulationScratch Scratch;
+	return FixTriangles(MaxIterations, Scratch);
+}
 
-	TArray<float> Radius;
-	Radius.SetNum(Total);
+template<typename AllocatorType>
+bool FTriangulation2D::FixTriangles(int32 MaxIterations, TTriangulationScratch<AllocatorType>& Scratch)
+{
+	ANGRY_TRIANGULATION_SCOPE(FixTriangles2D);
 
-	// Cache triange circumcircle
-	for (int32 Index = 0; Index < Total; Index++)
-	{
-		Circumcenter(Index, Centers[Index], Radius[Index]);
-	}
+	InvalidateVoronoi();
 
-	// Flip edges
-	for (int32 Iteration = 0; Iteration < Total; Iteration++)
+	// Most edges are already Delaunay, a batched filter rules those out before the robust predicates see them. Flips requeue their neighbours anyway
+	TArray<FGenTriangleEdge, AllocatorType>& FlipStack = Scratch.FlipStack;
+	TArray<FIntVector4, AllocatorType>& Quads = Scratch.Quads;
+	FlipStack.Reset(Triangles.Num() * 3 / 2);
+	Quads.Reset(Triangles.Num() * 3 / 2);
+	for (int32 Index = 0; Index < Triangles.Num(); Index++)
 	{
-		bool Changed = false;
-		for (int32 Index = 0; Index < Total; Index++)
+		const FGenTriangle& Mine = Triangles[Index];
+		for (int32 Edge = 0; Edge < 3; Edge++)
 		{
-			if (MaxIterations-- == 0) return true;
-
-			FGenTriangle& Mine = Triangles[Index];
-
-			const FVector2D& Circ = Centers[Index];
-			const float RR = Radius[Index];
-
-			for (int32 MineEdge = 0; MineEdge < 3; MineEdge++)
+			const int32 Adj = Mine.Adjs[Edge];
+			if (Adj > Index && !(Constraints.Num() > 0 && IsConstrained(Mine.Verts[(Edge + 1) % 3], Mine.Verts[(Edge + 2) % 3])))
 			{
-				const int32 Adj = Mine.Adjs[MineEdge];
-				if (Triangles.IsValidIndex(Adj))
-				{
-					FGenTriangle& Your = Triangles[Adj];
-
-					// Check whether inside circumcircle
-					const int32 YourEdge = Your.OppositeOf(Mine);
-					const FVector2D D = Points[Your.Verts[YourEdge]];
-					const float CC = (Circ - D).SizeSquared();
-					if (CC < RR - SMALL_NUMBER)
-					{
-						const int32 MineNext = (MineEdge + 1) % 3;
-						Mine.Verts[MineNext] = Your.Verts[YourEdge];
-
-						const int32 YourNext = (YourEdge + 1) % 3;
-						Your.Verts[YourNext] = Mine.Verts[MineEdge];
-
-						const int32 MinePrev = (MineEdge + 2) % 3;
-						Your.Adjs[YourEdge] = Mine.Adjs[MinePrev];
-						Mine.Adjs[MinePrev] = Adj;
-
-						const int32 YourPrev = (YourEdge + 2) % 3;
-						Mine.Adjs[MineEdge] = Your.Adjs[YourPrev];
-						Your.Adjs[YourPrev] = Index;
-
-						if (Triangles.IsValidIndex(Mine.Adjs[MineEdge]))
-						{
-							const int32 Opp = Triangles[Mine.Adjs[MineEdge]].OppositeOf(Mine);
-							if (Opp == INDEX_NONE)
-							{
-								return false;
-							}
-
-							Triangles[Mine.Adjs[MineEdge]].Adjs[Opp] = Index;
-						}
-
-						if (Triangles.IsValidIndex(Your.Adjs[YourEdge]))
-						{
-							const int32 Opp = Triangles[Your.Adjs[YourEdge]].OppositeOf(Your);
-							if (Opp == INDEX_NONE)
-							{
-								return false;
-							}
-
-							Triangles[Your.Adjs[YourEdge]].Adjs[Opp] = Adj;
-						}
-
-						Circumcenter(Index, Centers[Index], Radius[Index]);
-						Circumcenter(Adj, Centers[Adj], Radius[Adj]);
-						Changed = true;
-						break;
-					}
-				}
+				const FGenTriangle& Your = Triangles[Adj];
+				FlipStack.Emplace(FGenTriangleEdge(Index, Edge));
+				Quads.Emplace(FIntVector4(Mine.Verts[(Edge + 1) % 3], Mine.Verts[(Edge + 2) % 3], Mine.Verts[Edge], Your.Verts[Your.OppositeOf(Mine)]));
 			}
 		}
+	}
 
-		// No need to keep going if nothing changed
-		if (!Changed)
+	TArray<int8, AllocatorType>& Signs = Scratch.Signs;
+	Signs.SetNumUninitialized(Quads.Num(), false);
+	FGeometricPredicates::ClassifyInCircles(Points, Quads, Signs);
+	Counters.CircleTests += Quads.Num();
+	INC_DWORD_STAT_BY(STAT_AngryTriangulation_CircleTests, Quads.Num());
+
+	int32 Count = 0;
+	for (int32 Index = 0; Index < FlipStack.Num(); Index++)
+	{
+		if (Signs[Index] >= 0)
 		{
-			break;
+			FlipStack[Count++] = FlipStack[Index];
 		}
 	}
+	FlipStack.SetNum(Count, false);
+
+	// Flipping in place beat converting to the half-edge layout and back, the conversion alone took as long as legalizing an already Delaunay mesh
+	LegalizeEdges(FlipStack, nullptr, true, MaxIterations);
+	Scratch.UpdatePeak();
 	return true;
 }
 
+template ANGRYPROCEDURALTOOLS_API bool FTriangulation2D::FixTriangles<FDefaultAllocator>(int32 MaxIterations, FTriangulationScratch& Scratch);
+template ANGRYPROCEDURALTOOLS_API bool FTriangulation2D::FixTriangles<TMemStackAllocator<>>(int32 MaxIterations, FTriangulationMemStackScratch& Scratch);
+
 int32 FTriangulation2D::CutEdge(int32 TriangleIndex, int32 NeighbourIndex, int32 Edge, int32 PointIndex)
 {
+	ANGRY_TRIANGULATION_SCOPE(CutEdge);
+
+	InvalidateVoronoi();
+
 	const int32 NextIndex = (Edge + 1) % 3;
 	const int32 PrevIndex = (Edge + 2) % 3;
 
@@ -406,263 +781,2606 @@ int32 FTriangulation2D::CutEdge(int32 TriangleIndex, int32 NeighbourIndex, int32
 	New.Verts[NextIndex] = PointIndex;
 	Triangle.Verts[PrevIndex] = PointIndex;
 
-	return Triangles.Emplace(New);
+	const int32 NewIndex = AllocateTriangle();
+	Triangles[NewIndex] = New;
+	return NewIndex;
 }
 
-int32 FTriangulation2D::FindTriangle(const FVector2D& Point) const
+int32 FTriangulation2D::FindTriangleLinear(const FVector2D& Point) const
 {
+	Counters.LocateFallbacks++;
+	INC_DWORD_STAT(STAT_AngryTriangulation_LocateFallbacks);
+
 	const int32 Num = Triangles.Num();
 	for (int32 Index = 0; Index < Num; Index++)
 	{
+		// Same exact edge test as the walk, tolerances scale badly with triangle size
 		const FGenTriangle& Center = Triangles[Index];
-		const FVector Area = ComputeArea(Center);
-		if (Area.SizeSquared() < SMALL_NUMBER)
-		{
-			// Error handling?
-		}
-		else
+		if (Center.IsFreeSlot()) continue;
+
+		const FVector2D& A = Points[Center.Verts[0]];
+		const FVector2D& B = Points[Center.Verts[1]];
+		const FVector2D& C = Points[Center.Verts[2]];
+		if (FGeometricPredicates::Orient2D(A, B, C) < 0.0 &&
+			FGeometricPredicates::Orient2D(B, C, Point) <= 0.0 &&
+			FGeometricPredicates::Orient2D(C, A, Point) <= 0.0 &&
+			FGeometricPredicates::Orient2D(A, B, Point) <= 0.0)
 		{
-			const FVector Inside = InsideCheck(Center, Point);
-			const FVector Check = Inside * Area;
-			if (Check.GetMin() > -SMALL_NUMBER)
-			{
-				return Index;
-			}
+			return Index;
 		}
 	}
 	return INDEX_NONE;
 }
 
-
-void FTriangulation2D::SetBorders(const FVector2D& Min, const FVector2D& Max)
+void FTriangulation2D::BuildBuckets() const
 {
-	Points.Append({ FVector2D(Min.X, Min.Y) , FVector2D(Max.X, Min.Y) , FVector2D(Min.X, Max.Y) , FVector2D(Max.X, Max.Y) });
-	FGenTriangle Left(1, 0, 2);
-	Left.Adjs[1] = 1;
+	const int32 Num = Triangles.Num();
+	BucketNum = Num;
+	BucketBounds = FBox2D(Points);
+	BucketRes = FMath::Clamp(FMath::CeilToInt(FMath::Sqrt(Num * 0.5f)), 1, 1024);
+	Buckets.Init(INDEX_NONE, BucketRes * BucketRes);
 
-	FGenTriangle Right(3, 1, 2);
-	Right.Adjs[0] = 0;
+	// Remember any triangle with its center in each cell
+	for (int32 Index = 0; Index < Num; Index++)
+	{
+		const FGenTriangle& Triangle = Triangles[Index];
+		if (Triangle.IsFreeSlot()) continue;
 
-	Triangles.Append({ Left, Right });
+		const FVector2D Center = (Points[Triangle.Verts[0]] + Points[Triangle.Verts[1]] + Points[Triangle.Verts[2]]) / 3;
+		Buckets[GetBucket(Center)] = Index;
+	}
 }
 
-void FTriangulation2D::AddPoints(const FVector2D& Point)
+int32 FTriangulation2D::GetBucket(const FVector2D& Point) const
 {
-	const int32 CenterIndex = FindTriangle(Point);
-	if (Triangles.IsValidIndex(CenterIndex))
+	const FVector2D Size = FVector2D::Max(BucketBounds.GetSize(), FVector2D(SMALL_NUMBER));
+	const FVector2D Local = (Point - BucketBounds.Min) / Size;
+	const int32 X = FMath::Clamp(FMath::FloorToInt(Local.X * BucketRes), 0, BucketRes - 1);
+	const int32 Y = FMath::Clamp(FMath::FloorToInt(Local.Y * BucketRes), 0, BucketRes - 1);
+	return Y * BucketRes + X;
+}
+
+int32 FTriangulation2D::FindTriangle(const FVector2D& Point) const
+{
+	const int32 Num = Triangles.Num();
+	if (Num == 0)
 	{
-		FGenTriangle& Center = Triangles[CenterIndex];
-		const FVector Area = ComputeArea(Center);
-		const FVector Inside = InsideCheck(Center, Point);
-		const FVector Check = Inside * Area;
+		return INDEX_NONE;
+	}
 
-		// Don't add exact match
-		if ((Check.X < SMALL_NUMBER ? 1 : 0) + (Check.Y < SMALL_NUMBER ? 1 : 0) + (Check.Z < SMALL_NUMBER ? 1 : 0) >= 2)
-		{
-			return;
-		}
+	// Buckets only need rebuilding after the triangulation grew a lot, stale entries are still valid start triangles
+	if (Num > BucketNum * 2)
+	{
+		BuildBuckets();
+	}
 
-		// Point is definitely added
-		const int32 PointIndex = Points.Emplace(Point);
+	// Start from whichever of the last triangle and the bucket is closer, the last one usually wins for sorted inserts
+	const auto Distance = [&](int32 Index) -> double
+	{
+		const FGenTriangle& Triangle = Triangles[Index];
+		return (Points[Triangle.Verts[0]] - Point).SizeSquared();
+	};
 
-		// Special behaviour for edge hit
-		for (int32 Edge = 0; Edge < 3; Edge++)
+	int32 Current = Triangles.IsValidIndex(LastTriangle) ? LastTriangle : 0;
+	const int32 Bucket = Buckets[GetBucket(Point)];
+	if (Triangles.IsValidIndex(Bucket) && !Triangles[Bucket].IsFreeSlot() && (Triangles[Current].IsFreeSlot() || Distance(Bucket) < Distance(Current)))
+	{
+		Current = Bucket;
+	}
+	if (Triangles[Current].IsFreeSlot())
+	{
+		return FindTriangleLinear(Point);
+	}
+
+	// Walk towards the point, starting at a random edge so we can't cycle on degenerate triangles
+	uint32 Seed = (uint32)Current * 2654435761u + 1;
+	int32 Previous = INDEX_NONE;
+	int32 Found = INDEX_NONE;
+	bool Outside = false;
+	int32 Step = 0;
+	while (Step < Num && Found == INDEX_NONE && !Outside)
+	{
+		const FGenTriangle& Triangle = Triangles[Current];
+		Step++;
+
+		Seed ^= Seed << 13;
+		Seed ^= Seed >> 17;
+		Seed ^= Seed << 5;
+		const int32 Offset = Seed % 3;
+
+		int32 Next = INDEX_NONE;
+		for (int32 Index = 0; Index < 3; Index++)
+		{
+			const int32 Edge = (Offset + Index) % 3;
+			const int32 Adj = Triangle.Adjs[Edge];
+			if (Adj == Previous && Adj != INDEX_NONE) continue;
+
+			// Triangles are clockwise, the point is behind this edge if it lies to its left
+			const FVector2D& From = Points[Triangle.Verts[(Edge + 1) % 3]];
+			const FVector2D& To = Points[Triangle.Verts[(Edge + 2) % 3]];
+			if (FGeometricPredicates::Orient2D(From, To, Point) > 0.0)
+			{
+				Next = Adj;
+
+				// Outside the border, only convex triangulations can be sure
+				Outside = Next == INDEX_NONE;
+				break;
+			}
+		}
+
+		if (Next == INDEX_NONE)
+		{
+			Found = Outside ? INDEX_NONE : Current;
+		}
+		else
+		{
+			Previous = Current;
+			Current = Next;
+		}
+	}
+
+	FTriangulationCounters Work;
+	Work.LocateSteps = Step;
+
+	// Walk didn't converge
+	Work.CapHits = (Found == INDEX_NONE && !Outside) ? 1 : 0;
+	PublishTriangulationCounters(Counters, Work);
+
+	if (Found == INDEX_NONE)
+	{
+		return FindTriangleLinear(Point);
+	}
+	LastTriangle = Found;
+	return Found;
+}
+
+void FTriangulation2D::ResetLocation()
+{
+	Buckets.Reset();
+	BucketNum = 0;
+	LastTriangle = INDEX_NONE;
+}
+
+void FTriangulation2D::SetBorders(const FVector2D& Min, const FVector2D& Max)
+{
+	InvalidateVoronoi();
+
+	Points.Append({ FVector2D(Min.X, Min.Y) , FVector2D(Max.X, Min.Y) , FVector2D(Min.X, Max.Y) , FVector2D(Max.X, Max.Y) });
+	FGenTriangle Left(1, 0, 2);
+	Left.Adjs[1] = 1;
+
+	FGenTriangle Right(3, 1, 2);
+	Right.Adjs[0] = 0;
+
+	Triangles.Append({ Left, Right });
+}
+
+int32 FTriangulation2D::AddPoints(const FVector2D& Point)
+{
+	FTriangulationScratch Scratch;
+	return AddPoints(Point, Scratch);
+}
+
+template<typename AllocatorType>
+int32 FTriangulation2D::AddPoints(const FVector2D& Point, TTriangulationScratch<AllocatorType>& Scratch)
+{
+	ANGRY_TRIANGULATION_SCOPE(AddPoint);
+
+	const int32 PointIndex = Points.Emplace(Point);
+	const int32 Vertex = InsertVertex(PointIndex, Scratch.FlipStack);
+	if (Vertex != PointIndex)
+	{
+		Points.Pop(false);
+	}
+	Scratch.UpdatePeak();
+	return Vertex;
+}
+
+template ANGRYPROCEDURALTOOLS_API int32 FTriangulation2D::AddPoints<FDefaultAllocator>(const FVector2D& Point, FTriangulationScratch& Scratch);
+template ANGRYPROCEDURALTOOLS_API int32 FTriangulation2D::AddPoints<TMemStackAllocator<>>(const FVector2D& Point, FTriangulationMemStackScratch& Scratch);
+
+template<typename AllocatorType>
+int32 FTriangulation2D::SplitEdge(int32 TriangleIndex, int32 Edge, int32 PointIndex, TArray<FGenTriangleEdge, AllocatorType>& FlipStack)
+{
+	InvalidateVoronoi();
+	FlipStack.Reset();
+
+	const FGenTriangle& Center = Triangles[TriangleIndex];
+	const int32 EdgeNext = (Edge + 1) % 3;
+	const int32 EdgePrev = (Edge + 2) % 3;
+
+	// Constraint continues through the new point
+	const uint64 Key = MakeEdgeKey(Center.Verts[EdgeNext], Center.Verts[EdgePrev]);
+	if (Constraints.Remove(Key) > 0)
+	{
+		Constraints.Add(MakeEdgeKey(Center.Verts[EdgeNext], PointIndex));
+		Constraints.Add(MakeEdgeKey(PointIndex, Center.Verts[EdgePrev]));
+	}
+
+	// Cut neighbour if available
+	const int32 OppIndex = Center.Adjs[Edge];
+	int32 OppNew = INDEX_NONE;
+	int32 OppEdge = INDEX_NONE;
+	if (Triangles.IsValidIndex(OppIndex))
+	{
+		OppEdge = Triangles[OppIndex].OppositeOf(Center);
+		const int32 OppNext = (OppEdge + 1) % 3;
+		const int32 OppPrev = (OppEdge + 2) % 3;
+		OppNew = CutEdge(OppIndex, TriangleIndex, OppEdge, PointIndex);
+
+		// Both halves face the halves of the center triangle created below
+		FGenTriangle& Opp = Triangles[OppIndex];
+		Opp.Adjs[OppNext] = OppNew;
+
+		FGenTriangle& Cut = Triangles[OppNew];
+		Cut.Adjs[OppEdge] = TriangleIndex;
+		Cut.Adjs[OppPrev] = OppIndex;
+		if (Triangles.IsValidIndex(Cut.Adjs[OppNext]))
+		{
+			Triangles[Cut.Adjs[OppNext]].ReplaceAdj(OppIndex, OppNew);
+		}
+
+		FlipStack.Emplace(FGenTriangleEdge(OppIndex, OppPrev));
+		FlipStack.Emplace(FGenTriangleEdge(OppNew, OppNext));
+	}
+
+	const int32 New = CutEdge(TriangleIndex, OppIndex, Edge, PointIndex);
+	if (Triangles.IsValidIndex(OppIndex))
+	{
+		Triangles[OppIndex].Adjs[OppEdge] = New;
+	}
+
+	FGenTriangle& Mine = Triangles[TriangleIndex];
+	Mine.Adjs[Edge] = OppNew;
+	Mine.Adjs[EdgeNext] = New;
+
+	FGenTriangle& Cut = Triangles[New];
+	Cut.Adjs[Edge] = OppIndex;
+	Cut.Adjs[EdgePrev] = TriangleIndex;
+	if (Triangles.IsValidIndex(Cut.Adjs[EdgeNext]))
+	{
+		Triangles[Cut.Adjs[EdgeNext]].ReplaceAdj(TriangleIndex, New);
+	}
+
+	FlipStack.Emplace(FGenTriangleEdge(TriangleIndex, EdgePrev));
+	FlipStack.Emplace(FGenTriangleEdge(New, EdgeNext));
+	LegalizeEdges(FlipStack);
+	return PointIndex;
+}
+
+int32 FTriangulation2D::InsertVertex(int32 PointIndex)
+{
+	TArray<FGenTriangleEdge> FlipStack;
+	return InsertVertex(PointIndex, FlipStack);
+}
+
+template<typename AllocatorType>
+int32 FTriangulation2D::InsertVertex(int32 PointIndex, TArray<FGenTriangleEdge, AllocatorType>& FlipStack)
+{
+	InvalidateVoronoi();
+
+	const FVector2D Point = Points[PointIndex];
+	const int32 CenterIndex = FindTriangle(Point);
+	if (Triangles.IsValidIndex(CenterIndex))
+	{
+		const FGenTriangle& Center = Triangles[CenterIndex];
+		const FVector Area = ComputeArea(Center);
+		if (Area.X == 0.0)
+		{
+			return INDEX_NONE;
+		}
+
+		// Barycentric coordinates are independent of triangle size
+		const FVector Inside = InsideCheck(Center, Point);
+		const FVector Check = Inside / Area;
+		const double Threshold = 1e-10;
+
+		// Don't add exact match
+		if ((Check.X < Threshold ? 1 : 0) + (Check.Y < Threshold ? 1 : 0) + (Check.Z < Threshold ? 1 : 0) >= 2)
+		{
+			return Center.Verts[Check.GetMax() == Check.X ? 0 : (Check.GetMax() == Check.Y ? 1 : 2)];
+		}
+
+		// Point is definitely added
+		FlipStack.Reset();
+
+		// Special behaviour for edge hit
+		for (int32 Edge = 0; Edge < 3; Edge++)
+		{
+			if (Check[Edge] < Threshold)
+			{
+				return SplitEdge(CenterIndex, Edge, PointIndex, FlipStack);
+			}
+		}
+
+		// Hook up vertices and ajdacency lists
+		FGenTriangle Left(Center);
+		FGenTriangle Right(Center);
+		const int32 RightIndex = AllocateTriangle();
+		const int32 LeftIndex = AllocateTriangle();
+
+		Right.Verts[1] = PointIndex;
+		Right.Adjs[0] = CenterIndex;
+		Right.Adjs[2] = LeftIndex;
+
+		Left.Verts[2] = PointIndex;
+		Left.Adjs[0] = CenterIndex;
+		Left.Adjs[1] = RightIndex;
+
+		FGenTriangle& Mine = Triangles[CenterIndex];
+		Mine.Verts[0] = PointIndex;
+		Mine.Adjs[1] = RightIndex;
+		Mine.Adjs[2] = LeftIndex;
+
+		if (Triangles.IsValidIndex(Right.Adjs[1])) Triangles[Right.Adjs[1]].ReplaceAdj(CenterIndex, RightIndex);
+		if (Triangles.IsValidIndex(Left.Adjs[2])) Triangles[Left.Adjs[2]].ReplaceAdj(CenterIndex, LeftIndex);
+
+		Triangles[RightIndex] = Right;
+		Triangles[LeftIndex] = Left;
+
+		FlipStack.Append({ FGenTriangleEdge(CenterIndex, 0), FGenTriangleEdge(RightIndex, 1), FGenTriangleEdge(LeftIndex, 2) });
+		LegalizeEdges(FlipStack);
+		return PointIndex;
+	}
+	return INDEX_NONE;
+}
+
+int32 FTriangulation2D::ExtendHull(int32 PointIndex, int32 HullVertex)
+{
+	InvalidateVoronoi();
+
+	const FVector2D& Point = Points[PointIndex];
+
+	// Rotates around a hull vertex to its border edge, direction 1 finds the edge ending and 2 the edge starting at the vertex
+	const auto BorderAt = [this](int32 Triangle, int32 Vert, int32 Direction)
+	{
+		for (int32 Step = 0; Step < Triangles.Num(); Step++)
+		{
+			const FGenTriangle& Current = Triangles[Triangle];
+			const int32 Slot = Current.Verts[0] == Vert ? 0 : (Current.Verts[1] == Vert ? 1 : 2);
+			const int32 Edge = (Slot + Direction) % 3;
+			if (!Triangles.IsValidIndex(Current.Adjs[Edge]))
+			{
+				return FGenTriangleEdge(Triangle, Edge);
+			}
+			Triangle = Current.Adjs[Edge];
+		}
+		return FGenTriangleEdge(INDEX_NONE, INDEX_NONE);
+	};
+
+	const auto NextBorder = [&](const FGenTriangleEdge& Border) { return BorderAt(Border.T, Triangles[Border.T].Verts[(Border.E + 2) % 3], 2); };
+	const auto PrevBorder = [&](const FGenTriangleEdge& Border) { return BorderAt(Border.T, Triangles[Border.T].Verts[(Border.E + 1) % 3], 1); };
+
+	// Triangles are clockwise so outside is to the left
+	const auto Sees = [&](const FGenTriangleEdge& Border)
+	{
+		const FGenTriangle& Triangle = Triangles[Border.T];
+		return FGeometricPredicates::Orient2D(Points[Triangle.Verts[(Border.E + 1) % 3]], Points[Triangle.Verts[(Border.E + 2) % 3]], Point) > 0.0;
+	};
+
+	// Start on the hull at the given vertex, only fall back to searching for any border edge without one
+	FGenTriangleEdge Start(INDEX_NONE, INDEX_NONE);
+	TArray<int32> Fan;
+	if (Points.IsValidIndex(HullVertex))
+	{
+		GetVertexFan(HullVertex, Fan);
+	}
+	if (Fan.Num() > 0)
+	{
+		Start = BorderAt(Fan[0], HullVertex, 2);
+	}
+	for (int32 Index = 0; Index < Triangles.Num() && Start.T == INDEX_NONE; Index++)
+	{
+		const FGenTriangle& Triangle = Triangles[Index];
+		if (Triangle.IsFreeSlot()) continue;
+
+		for (int32 Edge = 0; Edge < 3 && Start.T == INDEX_NONE; Edge++)
+		{
+			if (Triangle.Adjs[Edge] == INDEX_NONE)
+			{
+				Start = FGenTriangleEdge(Index, Edge);
+			}
+		}
+	}
+
+	if (Start.T == INDEX_NONE)
+	{
+		return INDEX_NONE;
+	}
+
+	// Edges a point sees on a convex hull are consecutive, walk to any of them and then back to the first
+	FGenTriangleEdge Begin = Start;
+	int32 Steps = 0;
+	while (!Sees(Begin))
+	{
+		Begin = NextBorder(Begin);
+		if (Begin.T == INDEX_NONE || ++Steps > Triangles.Num() || (Begin.T == Start.T && Begin.E == Start.E))
+		{
+			return INDEX_NONE;
+		}
+	}
+
+	const FGenTriangleEdge First = Begin;
+	for (FGenTriangleEdge Prev = PrevBorder(Begin); Prev.T != INDEX_NONE && Sees(Prev) && !(Prev.T == First.T && Prev.E == First.E); Prev = PrevBorder(Prev))
+	{
+		Begin = Prev;
+	}
+
+	TArray<FGenTriangleEdge> Visible = { Begin };
+	for (FGenTriangleEdge Next = NextBorder(Begin); Next.T != INDEX_NONE && Sees(Next) && !(Next.T == Begin.T && Next.E == Begin.E); Next = NextBorder(Next))
+	{
+		Visible.Emplace(Next);
+	}
+
+	// Neighbouring new triangles share the spoke to the vertex between their border edges
+	TArray<FGenTriangleEdge> FlipStack;
+	int32 Previous = INDEX_NONE;
+	for (const FGenTriangleEdge& Border : Visible)
+	{
+		const FGenTriangle& Triangle = Triangles[Border.T];
+		FGenTriangle Outer(Triangle.Verts[(Border.E + 2) % 3], Triangle.Verts[(Border.E + 1) % 3], PointIndex);
+		Outer.Adjs[2] = Border.T;
+		Outer.Adjs[0] = Previous;
+
+		const int32 New = AllocateTriangle();
+		Triangles[New] = Outer;
+		Triangles[Border.T].Adjs[Border.E] = New;
+		if (Previous != INDEX_NONE)
+		{
+			Triangles[Previous].Adjs[1] = New;
+		}
+		Previous = New;
+		FlipStack.Emplace(FGenTriangleEdge(New, 2));
+	}
+
+	LegalizeEdges(FlipStack);
+	LastTriangle = Previous;
+	return PointIndex;
+}
+
+void FTriangulation2D::AddPoints(TArrayView<const FVector2D> Batch)
+{
+	FTriangulationScratch Scratch;
+	AddPoints(Batch, Scratch);
+}
+
+template<typename AllocatorType>
+void FTriangulation2D::AddPoints(TArrayView<const FVector2D> Batch, TTriangulationScratch<AllocatorType>& Scratch)
+{
+	ANGRY_TRIANGULATION_SCOPE(AddPoints);
+
+	// Nothing to walk on yet
+	if (Triangles.Num() == 0)
+	{
+		TArray<FVector2D> Cloud = Points;
+		Cloud.Append(Batch);
+		QHull(MoveTemp(Cloud), -1, true, Scratch);
+		return;
+	}
+
+	const int32 Num = Batch.Num();
+	if (Num == 0)
+	{
+		return;
+	}
+
+	// Biased randomized insertion order, rounds double in size
+	TArray<int32, AllocatorType>& Order = Scratch.Order;
+	Order.SetNumUninitialized(Num, false);
+	for (int32 Index = 0; Index < Num; Index++)
+	{
+		Order[Index] = Index;
+	}
+
+	FRandomStream Random(Num);
+	for (int32 Index = Num - 1; Index > 0; Index--)
+	{
+		Order.Swap(Index, Random.RandRange(0, Index));
+	}
+
+	// Sort each round along a Hilbert curve so consecutive points are close together
+	const int32 HilbertOrder = 16;
+	FBox2D Bounds(ForceInit);
+	for (const FVector2D& Point : Batch)
+	{
+		Bounds += Point;
+	}
+
+	const FVector2D Scale = FVector2D((1 << HilbertOrder) - 1) / FVector2D::Max(Bounds.GetSize(), FVector2D(SMALL_NUMBER));
+
+	TArray<uint64, AllocatorType>& Keys = Scratch.Keys;
+	Keys.SetNumUninitialized(Num, false);
+	for (int32 Index = 0; Index < Num; Index++)
+	{
+		const FVector2D Cell = (Batch[Index] - Bounds.Min) * Scale;
+		Keys[Index] = HilbertIndex((uint32)Cell.X, (uint32)Cell.Y, HilbertOrder);
+	}
+
+	int32 Start = 0;
+	int32 Size = FMath::Min(Num, 16);
+	while (Start < Num)
+	{
+		TArrayView<int32> Round(Order.GetData() + Start, Size);
+		Algo::Sort(Round, [&Keys](int32 A, int32 B) { return Keys[A] < Keys[B]; });
+
+		Start += Size;
+		Size = FMath::Min(Size * 2, Num - Start);
+	}
+
+	Points.Reserve(Points.Num() + Num);
+	Triangles.Reserve(Triangles.Num() + Num * 2);
+	for (int32 Index : Order)
+	{
+		const int32 PointIndex = Points.Emplace(Batch[Index]);
+		if (InsertVertex(PointIndex, Scratch.FlipStack) != PointIndex)
+		{
+			Points.Pop(false);
+		}
+	}
+	Scratch.UpdatePeak();
+}
+
+template ANGRYPROCEDURALTOOLS_API void FTriangulation2D::AddPoints<FDefaultAllocator>(TArrayView<const FVector2D> Batch, FTriangulationScratch& Scratch);
+template ANGRYPROCEDURALTOOLS_API void FTriangulation2D::AddPoints<TMemStackAllocator<>>(TArrayView<const FVector2D> Batch, FTriangulationMemStackScratch& Scratch);
+
+template<typename AllocatorType>
+void FTriangulation2D::LegalizeEdges(TArray<FGenTriangleEdge, AllocatorType>& FlipStack, TArray<int32, TIdentity_T<AllocatorType>>* HullTri, bool AllEdges, int32 MaxChecks)
+{
+	InvalidateVoronoi();
+
+	FTriangulationCounters Work;
+	while (FlipStack.Num() > 0)
+	{
+		if (MaxChecks-- == 0)
+		{
+			Work.CapHits++;
+			break;
+		}
+
+		const FGenTriangleEdge Edge = FlipStack.Pop(false);
+		const FGenTriangle& Mine = Triangles[Edge.T];
+		const int32 Adj = Mine.Adjs[Edge.E];
+		if (Adj == INDEX_NONE) continue;
+
+		const FGenTriangle& Your = Triangles[Adj];
+		const int32 YourEdge = Your.OppositeOf(Mine);
+		if (YourEdge == INDEX_NONE) continue;
+		if (IsConstrained(Mine.Verts[(Edge.E + 1) % 3], Mine.Verts[(Edge.E + 2) % 3])) continue;
+
+		Work.CircleTests++;
+		if (!InsideCircumcircle(Points[Mine.Verts[0]], Points[Mine.Verts[1]], Points[Mine.Verts[2]], Points[Your.Verts[YourEdge]])) continue;
+		if (FlipEdge(Edge.T, Edge.E) == INDEX_NONE) continue;
+		Work.Flips++;
+
+		// Hull edges can move to the other triangle
+		if (HullTri)
+		{
+			const FGenTriangle& NewMine = Triangles[Edge.T];
+			if (NewMine.Adjs[Edge.E] == INDEX_NONE)
+			{
+				(*HullTri)[NewMine.Verts[(Edge.E + 1) % 3]] = Edge.T;
+			}
+
+			const FGenTriangle& NewYour = Triangles[Adj];
+			if (NewYour.Adjs[YourEdge] == INDEX_NONE)
+			{
+				(*HullTri)[NewYour.Verts[(YourEdge + 1) % 3]] = Adj;
+			}
+		}
+
+		// Inserted point stays at the same index in Mine and ends up after the old opposite vertex in Your
+		FlipStack.Emplace(FGenTriangleEdge(Edge.T, Edge.E));
+		FlipStack.Emplace(FGenTriangleEdge(Adj, (YourEdge + 1) % 3));
+		if (AllEdges)
+		{
+			FlipStack.Emplace(FGenTriangleEdge(Edge.T, (Edge.E + 1) % 3));
+			FlipStack.Emplace(FGenTriangleEdge(Adj, YourEdge));
+		}
+	}
+	PublishTriangulationCounters(Counters, Work);
+}
+
+template ANGRYPROCEDURALTOOLS_API void FTriangulation2D::LegalizeEdges<FDefaultAllocator>(TArray<FGenTriangleEdge>& FlipStack, TArray<int32>* HullTri, bool AllEdges, int32 MaxChecks);
+template ANGRYPROCEDURALTOOLS_API void FTriangulation2D::LegalizeEdges<TMemStackAllocator<>>(TArray<FGenTriangleEdge, TMemStackAllocator<>>& FlipStack, TArray<int32, TMemStackAllocator<>>* HullTri, bool AllEdges, int32 MaxChecks);
+
+
+void FTriangulation2D::QHull(TArray<FVector2D> Cloud, int32 Iterations, bool Legalize)
+{
+	FTriangulationScratch Scratch;
+	QHull(MoveTemp(Cloud), Iterations, Legalize, Scratch);
+}
+
+template<typename AllocatorType>
+void FTriangulation2D::QHull(TArray<FVector2D> Cloud, int32 Iterations, bool Legalize, TTriangulationScratch<AllocatorType>& Scratch)
+{
+	ANGRY_TRIANGULATION_SCOPE(QHull);
+
+	Reset();
+	Points = MoveTemp(Cloud);
+
+	const int32 Num = Points.Num();
+	if (Num > 2)
+	{
+		FVector2D Mean = FVector2D::ZeroVector;
+		for (const FVector2D& Point : Points)
+		{
+			Mean += Point;
+		}
+		Mean /= Num;
+
+		// Get closest point to mean
+		int32 I0 = INDEX_NONE;
+		double ClosestD0 = DBL_MAX;
+		for (int32 Index = 0; Index < Num; Index++)
+		{
+			const double D0 = (Points[Index] - Mean).SizeSquared();
+			if (D0 < ClosestD0)
+			{
+				ClosestD0 = D0;
+				I0 = Index;
+			}
+		}
+		const FVector2D P0 = Points[I0];
+
+		// Get next closest point
+		int32 I1 = INDEX_NONE;
+		double ClosestD1 = DBL_MAX;
+		for (int32 Index = 0; Index < Num; Index++)
+		{
+			const double D1 = (Points[Index] - P0).SizeSquared();
+			if (Index != I0 && D1 < ClosestD1 && D1 > 0.0)
+			{
+				ClosestD1 = D1;
+				I1 = Index;
+			}
+		}
+
+		if (I1 == INDEX_NONE)
+		{
+			return;
+		}
+		const FVector2D P1 = Points[I1];
+
+		// Find smallest circumcircle
+		int32 I2 = INDEX_NONE;
+		double ClosestDQ = DBL_MAX;
+		FVector2D Circ = FVector2D::ZeroVector;
+		for (int32 Index = 0; Index < Num; Index++)
+		{
+			if (Index == I0 || Index == I1) continue;
+
+			FVector2D Center;
+			if (UTriangleMath::ComputeCircumcenter2D(P0, P1, Points[Index], Center))
+			{
+				const double CQ = (Center - P0).SizeSquared();
+				if (CQ < ClosestDQ)
+				{
+					ClosestDQ = CQ;
+					Circ = Center;
+					I2 = Index;
+				}
+			}
+		}
+
+		if (I2 == INDEX_NONE)
+		{
+			return;
+		}
+
+		// Create Triangle
+		const FVector2D P2 = Points[I2];
+		const FGenTriangle Seed = (FGeometricPredicates::Orient2D(P0, P2, P1) < 0.0) ? FGenTriangle(I1, I0, I2) : FGenTriangle(I2, I0, I1);
+		Triangles.Reserve(Num * 2);
+		const int32 CT = Triangles.Emplace(Seed);
+
+		// Sort remaining points away from circumcircle
+		TArray<int32, AllocatorType>& Order = Scratch.Order;
+		Order.Reset(Num);
+		TArray<double, AllocatorType>& Dists = Scratch.Dists;
+		Dists.SetNumUninitialized(Num, false);
+		for (int32 Index = 0; Index < Num; Index++)
+		{
+			Dists[Index] = (Points[Index] - Circ).SizeSquared();
+			if (Index != I0 && Index != I1 && Index != I2)
+			{
+				Order.Emplace(Index);
+			}
+		}
+		// Ties sorted by index so the first of several duplicates is always the one kept
+		Order.Sort([&Dists](int32 A, int32 B) -> bool { return Dists[A] < Dists[B] || (Dists[A] == Dists[B] && A < B); });
+
+		// Create convex hull as a linked list along the triangle winding, where HullTri stores the triangle owning the edge starting at each vertex
+		TArray<int32, AllocatorType>& HullNext = Scratch.HullNext;
+		TArray<int32, AllocatorType>& HullPrev = Scratch.HullPrev;
+		TArray<int32, AllocatorType>& HullTri = Scratch.HullTri;
+		HullNext.Init(INDEX_NONE, Num);
+		HullPrev.Init(INDEX_NONE, Num);
+		HullTri.Init(INDEX_NONE, Num);
+
+		// Hash hull vertices by angle around the circumcircle to find a visible edge quickly
+		const int32 HashSize = FMath::Max(FMath::CeilToInt(FMath::Sqrt((float)Num)), 1);
+		TArray<int32, AllocatorType>& HullHash = Scratch.HullHash;
+		HullHash.Init(INDEX_NONE, HashSize);
+		const auto HashKey = [&](const FVector2D& Point) -> int32
+		{
+			return FMath::FloorToInt(PseudoAngle(Point - Circ) * HashSize) % HashSize;
+		};
+
+		for (int32 Vert = 0; Vert < 3; Vert++)
+		{
+			const int32 Index = Seed.Verts[Vert];
+			HullNext[Index] = Seed.Verts[(Vert + 1) % 3];
+			HullPrev[Index] = Seed.Verts[(Vert + 2) % 3];
+			HullTri[Index] = CT;
+			HullHash[HashKey(Points[Index])] = Index;
+		}
+
+		// Hull edge starting at given vertex
+		const auto HullEdge = [&](int32 Vertex) -> FGenTriangleEdge
+		{
+			const FGenTriangle& Triangle = Triangles[HullTri[Vertex]];
+			const int32 Vert = (Triangle.Verts[0] == Vertex) ? 0 : ((Triangle.Verts[1] == Vertex) ? 1 : 2);
+			return FGenTriangleEdge(HullTri[Vertex], (Vert + 2) % 3);
+		};
+
+		// See whether hull edge is visible to Point
+		const auto IsVisible = [&](int32 Prev, int32 Next, const FVector2D& Point) -> bool
+		{
+			return FGeometricPredicates::Orient2D(Points[Prev], Points[Next], Point) > 0.0;
+		};
+
+		// Chain new triangle to the hull edge starting at Prev
+		const auto AddTriangle = [&](int32 Prev, int32 PointIndex, int32 Next) -> int32
+		{
+			const FGenTriangleEdge Edge = HullEdge(Prev);
+			FGenTriangle Triangle(Prev, PointIndex, Next);
+			Triangle.Adjs[1] = Edge.T;
+
+			const int32 TriangleIndex = Triangles.Emplace(Triangle);
+			Triangles[Edge.T].Adjs[Edge.E] = TriangleIndex;
+			return TriangleIndex;
+		};
+
+		TArray<FGenTriangleEdge, AllocatorType>& FlipStack = Scratch.FlipStack;
+		FlipStack.Reset();
+
+		for (int32 PointIndex : Order)
+		{
+			if (Iterations-- == 0)
+			{
+				Counters.CapHits++;
+				INC_DWORD_STAT(STAT_AngryTriangulation_CapHits);
+				break;
+			}
+
+			const FVector2D& Point = Points[PointIndex];
+
+			// Find a visible edge on the hull starting from the hashed vertex
+			const int32 Key = HashKey(Point);
+			int32 Start = INDEX_NONE;
+			for (int32 Offset = 0; Offset < HashSize; Offset++)
+			{
+				Start = HullHash[(Key + Offset) % HashSize];
+				if (Start != INDEX_NONE && HullNext[Start] != INDEX_NONE)
+				{
+					break;
+				}
+			}
+
+			if (Start == INDEX_NONE || HullNext[Start] == INDEX_NONE)
+			{
+				continue;
+			}
+
+			Start = HullPrev[Start];
+			int32 First = Start;
+			while (!IsVisible(First, HullNext[First], Point))
+			{
+				First = HullNext[First];
+				if (First == Start)
+				{
+					First = INDEX_NONE;
+					break;
+				}
+			}
+
+			// Point is inside the hull or a duplicate
+			if (First == INDEX_NONE)
+			{
+				continue;
+			}
+
+			// Construct triangles forward
+			const int32 NewTriangles = Triangles.Num();
+			int32 Last = HullNext[First];
+			int32 FirstTri = AddTriangle(First, PointIndex, Last);
+			int32 LastTri = FirstTri;
+			while (IsVisible(Last, HullNext[Last], Point))
+			{
+				const int32 Next = HullNext[Last];
+				const int32 TriangleIndex = AddTriangle(Last, PointIndex, Next);
+				Triangles[TriangleIndex].Adjs[2] = LastTri;
+				Triangles[LastTri].Adjs[0] = TriangleIndex;
+				LastTri = TriangleIndex;
+
+				HullNext[Last] = INDEX_NONE;
+				Last = Next;
+			}
+
+			// Construct triangles backward
+			while (IsVisible(HullPrev[First], First, Point))
+			{
+				const int32 Prev = HullPrev[First];
+				const int32 TriangleIndex = AddTriangle(Prev, PointIndex, First);
+				Triangles[TriangleIndex].Adjs[0] = FirstTri;
+				Triangles[FirstTri].Adjs[2] = TriangleIndex;
+				FirstTri = TriangleIndex;
+
+				HullNext[First] = INDEX_NONE;
+				First = Prev;
+			}
+
+			// Update convex hull
+			HullNext[First] = PointIndex;
+			HullPrev[PointIndex] = First;
+			HullNext[PointIndex] = Last;
+			HullPrev[Last] = PointIndex;
+			HullTri[First] = FirstTri;
+			HullTri[PointIndex] = LastTri;
+
+			HullHash[Key] = PointIndex;
+			HullHash[HashKey(Points[First])] = First;
+
+			if (Legalize)
+			{
+				for (int32 TriangleIndex = Triangles.Num() - 1; TriangleIndex >= NewTriangles; TriangleIndex--)
+				{
+					FlipStack.Emplace(FGenTriangleEdge(TriangleIndex, 1));
+				}
+				LegalizeEdges(FlipStack, &HullTri);
+			}
+		}
+		Scratch.UpdatePeak();
+	}
+}
+
+template ANGRYPROCEDURALTOOLS_API void FTriangulation2D::QHull<FDefaultAllocator>(TArray<FVector2D> Cloud, int32 Iterations, bool Legalize, FTriangulationScratch& Scratch);
+template ANGRYPROCEDURALTOOLS_API void FTriangulation2D::QHull<TMemStackAllocator<>>(TArray<FVector2D> Cloud, int32 Iterations, bool Legalize, FTriangulationMemStackScratch& Scratch);
+
+
+void FTriangulation2D::QHullParallel(TArray<FVector2D> Cloud, int32 StripeSize)
+{
+	ANGRY_TRIANGULATION_SCOPE(QHullParallel);
+
+	const int32 Num = Cloud.Num();
+	const int32 StripeNum = FMath::Clamp(Num / FMath::Max(StripeSize, 16), 1, 256);
+	if (StripeNum < 2)
+	{
+		QHull(MoveTemp(Cloud), -1, true);
+		return;
+	}
+
+	// Lexicographic order so stripes can be separated by vertical lines
+	TArray<int32> Order;
+	Order.SetNumUninitialized(Num);
+	for (int32 Index = 0; Index < Num; Index++)
+	{
+		Order[Index] = Index;
+	}
+
+	Algo::Sort(Order, [&Cloud](int32 A, int32 B)
+	{
+		return Cloud[A].X < Cloud[B].X || (Cloud[A].X == Cloud[B].X && (Cloud[A].Y < Cloud[B].Y || (Cloud[A].Y == Cloud[B].Y && A < B)));
+	});
+
+	// Never split a column of equal X
+	TArray<int32> Borders = { 0 };
+	for (int32 Stripe = 1; Stripe < StripeNum; Stripe++)
+	{
+		int32 Border = FMath::Max((int32)((int64)Stripe * Num / StripeNum), Borders.Last() + 1);
+		while (Border < Num && Cloud[Order[Border]].X == Cloud[Order[Border - 1]].X)
+		{
+			Border++;
+		}
+
+		if (Border < Num)
+		{
+			Borders.Emplace(Border);
+		}
+	}
+	Borders.Emplace(Num);
+
+	const int32 StripeCount = Borders.Num() - 1;
+	TArray<FTriangulation2D> Stripes;
+	Stripes.SetNum(StripeCount);
+	ParallelFor(StripeCount, [&](int32 Stripe)
+	{
+		TArray<FVector2D> Local;
+		Local.Reserve(Borders[Stripe + 1] - Borders[Stripe]);
+		for (int32 Index = Borders[Stripe]; Index < Borders[Stripe + 1]; Index++)
+		{
+			Local.Emplace(Cloud[Order[Index]]);
+		}
+		Stripes[Stripe].QHull(MoveTemp(Local), -1, true);
+	});
+
+	for (const FTriangulation2D& Stripe : Stripes)
+	{
+		Counters += Stripe.Counters;
+	}
+
+	Reset();
+	Points = MoveTemp(Cloud);
+
+	// Gather stripes with global indices and remember their hull, hull edges run clockwise
+	TArray<int32> HullTri;
+	TArray<int32> HullNext;
+	TArray<int32> HullPrev;
+	HullTri.Init(INDEX_NONE, Num);
+	HullNext.Init(INDEX_NONE, Num);
+	HullPrev.Init(INDEX_NONE, Num);
+
+	int32 TriangleNum = 0;
+	for (const FTriangulation2D& Stripe : Stripes)
+	{
+		TriangleNum += Stripe.Triangles.Num();
+	}
+	Triangles.Reserve(TriangleNum + Num);
+
+	bool Degenerate = false;
+	for (int32 Stripe = 0; Stripe < StripeCount; Stripe++)
+	{
+		const int32 Offset = Triangles.Num();
+		const int32 Base = Borders[Stripe];
+		Degenerate |= Stripes[Stripe].Triangles.Num() == 0;
+
+		for (FGenTriangle Triangle : Stripes[Stripe].Triangles)
+		{
+			for (int32 Edge = 0; Edge < 3; Edge++)
+			{
+				Triangle.Verts[Edge] = Order[Base + Triangle.Verts[Edge]];
+				if (Triangle.Adjs[Edge] != INDEX_NONE)
+				{
+					Triangle.Adjs[Edge] += Offset;
+				}
+			}
+
+			for (int32 Edge = 0; Edge < 3; Edge++)
+			{
+				if (Triangle.Adjs[Edge] == INDEX_NONE)
+				{
+					const int32 From = Triangle.Verts[(Edge + 1) % 3];
+					const int32 To = Triangle.Verts[(Edge + 2) % 3];
+					HullNext[From] = To;
+					HullPrev[To] = From;
+					HullTri[From] = Triangles.Num();
+				}
+			}
+			Triangles.Emplace(Triangle);
+		}
+	}
+
+	// Extreme points are always on the hull, duplicates never are
+	TArray<int32> Leftmost;
+	TArray<int32> Rightmost;
+	for (int32 Stripe = 0; Stripe < StripeCount && !Degenerate; Stripe++)
+	{
+		int32 Start = Borders[Stripe];
+		while (HullTri[Order[Start]] == INDEX_NONE) Start++;
+		Leftmost.Emplace(Order[Start]);
+
+		int32 End = Borders[Stripe + 1] - 1;
+		while (HullTri[Order[End]] == INDEX_NONE) End--;
+		Rightmost.Emplace(Order[End]);
+	}
+
+	for (int32 Stripe = 1; Stripe < StripeCount && !Degenerate; Stripe++)
+	{
+		Degenerate = !MergeHulls(Rightmost[Stripe - 1], Leftmost[Stripe], HullTri, HullNext, HullPrev);
+	}
+
+	// Collinear stripes can't be zipped, serial sweep handles those
+	if (Degenerate)
+	{
+		QHull(MoveTemp(Points), -1, true);
+	}
+}
+
+bool FTriangulation2D::MergeHulls(int32 Left, int32 Right, TArray<int32>& HullTri, TArray<int32>& HullNext, TArray<int32>& HullPrev)
+{
+	const int32 MaxSteps = Points.Num();
+
+	// Lower tangent, the left hull goes down clockwise and the right hull counter-clockwise
+	int32 LowerLeft = Left;
+	int32 LowerRight = Right;
+	for (int32 Step = 0; Step < MaxSteps; Step++)
+	{
+		if (FGeometricPredicates::Orient2D(Points[LowerLeft], Points[LowerRight], Points[HullNext[LowerLeft]]) < 0.0) LowerLeft = HullNext[LowerLeft];
+		else if (FGeometricPredicates::Orient2D(Points[LowerLeft], Points[LowerRight], Points[HullPrev[LowerRight]]) < 0.0) LowerRight = HullPrev[LowerRight];
+		else break;
+	}
+
+	int32 UpperLeft = Left;
+	int32 UpperRight = Right;
+	for (int32 Step = 0; Step < MaxSteps; Step++)
+	{
+		if (FGeometricPredicates::Orient2D(Points[UpperLeft], Points[UpperRight], Points[HullPrev[UpperLeft]]) > 0.0) UpperLeft = HullPrev[UpperLeft];
+		else if (FGeometricPredicates::Orient2D(Points[UpperLeft], Points[UpperRight], Points[HullNext[UpperRight]]) > 0.0) UpperRight = HullNext[UpperRight];
+		else break;
+	}
+
+	// Zip both facing chains upwards, starting at the lower tangent
+	TArray<FGenTriangleEdge> FlipStack;
+	FGenTriangleEdge Base;
+	int32 First = INDEX_NONE;
+	int32 L = LowerLeft;
+	int32 R = LowerRight;
+	while (L != UpperLeft || R != UpperRight)
+	{
+		const int32 LeftNext = HullPrev[L];
+		const int32 RightNext = HullNext[R];
+
+		// Candidates must lie above the base and the other chain can't continue into the angle of the new triangle
+		const double LeftOrient = FGeometricPredicates::Orient2D(Points[L], Points[R], Points[LeftNext]);
+		const double RightOrient = FGeometricPredicates::Orient2D(Points[L], Points[R], Points[RightNext]);
+		bool AdvanceLeft = L != UpperLeft && LeftOrient > 0.0 &&
+			(R == UpperRight || RightOrient <= 0.0 || FGeometricPredicates::Orient2D(Points[R], Points[LeftNext], Points[RightNext]) <= 0.0);
+		const bool AdvanceRight = R != UpperRight && RightOrient > 0.0 &&
+			(L == UpperLeft || LeftOrient <= 0.0 || FGeometricPredicates::Orient2D(Points[RightNext], Points[L], Points[LeftNext]) <= 0.0);
+
+		if (!AdvanceLeft && !AdvanceRight)
+		{
+			return false;
+		}
+
+		// Prefer whichever is Delaunay, legalization fixes up the rest
+		if (AdvanceLeft && AdvanceRight)
+		{
+			AdvanceLeft = FGeometricPredicates::InCirclePerturbed(Points[L], Points[R], Points[LeftNext], Points[RightNext]) <= 0.0;
+		}
+
+		// Link to the triangle of the clockwise hull edge we build on
+		const int32 Index = Triangles.Num();
+		const int32 Start = AdvanceLeft ? LeftNext : R;
+		const int32 Owner = HullTri[Start];
+		FGenTriangle& Other = Triangles[Owner];
+		const int32 Slot = Other.Verts[0] == Start ? 0 : (Other.Verts[1] == Start ? 1 : 2);
+		Other.Adjs[(Slot + 2) % 3] = Index;
+
+		FGenTriangle Triangle;
+		if (AdvanceLeft)
+		{
+			Triangle = FGenTriangle(L, LeftNext, R);
+			Triangle.Adjs[2] = Owner;
+		}
+		else
+		{
+			Triangle = FGenTriangle(L, RightNext, R);
+			Triangle.Adjs[0] = Owner;
+		}
+
+		Triangle.Adjs[1] = Base.T;
+		if (Base.T != INDEX_NONE)
+		{
+			Triangles[Base.T].Adjs[Base.E] = Index;
+		}
+		Triangles.Emplace(Triangle);
+		FlipStack.Append({ FGenTriangleEdge(Index, 0), FGenTriangleEdge(Index, 1), FGenTriangleEdge(Index, 2) });
+
+		if (First == INDEX_NONE)
+		{
+			First = Index;
+		}
+
+		if (AdvanceLeft)
+		{
+			Base = FGenTriangleEdge(Index, 0);
+			L = LeftNext;
+		}
+		else
+		{
+			Base = FGenTriangleEdge(Index, 2);
+			R = RightNext;
+		}
+	}
+
+	if (First == INDEX_NONE)
+	{
+		return false;
+	}
+
+	// Tangents become hull edges
+	HullNext[UpperLeft] = UpperRight;
+	HullPrev[UpperRight] = UpperLeft;
+	HullTri[UpperLeft] = Base.T;
+
+	HullNext[LowerRight] = LowerLeft;
+	HullPrev[LowerLeft] = LowerRight;
+	HullTri[LowerRight] = First;
+
+	LegalizeEdges(FlipStack, &HullTri, true);
+	return true;
+}
+
+bool FTriangulation2D::IsConstrained(int32 From, int32 To) const
+{
+	return Constraints.Num() > 0 && Constraints.Contains(MakeEdgeKey(From, To));
+}
+
+void FTriangulation2D::GetVertexFan(int32 Vertex, TArray<int32>& Fan, int32 Hint) const
+{
+	Fan.Reset();
+	if (!Points.IsValidIndex(Vertex))
+	{
+		return;
+	}
+
+	int32 Start = (Triangles.IsValidIndex(Hint) && !Triangles[Hint].IsFreeSlot() && Triangles[Hint].HasVertex(Vertex)) ? Hint : FindTriangle(Points[Vertex]);
+	if (!Triangles.IsValidIndex(Start) || !Triangles[Start].HasVertex(Vertex))
+	{
+		Start = Triangles.IndexOfByPredicate([Vertex](const FGenTriangle& Triangle) { return Triangle.HasVertex(Vertex); });
+		if (Start == INDEX_NONE)
+		{
+			return;
+		}
+	}
+
+	// Rotate one way until we come back around or hit the border, then the other way
+	Fan.Emplace(Start);
+	for (int32 Direction = 1; Direction <= 2; Direction++)
+	{
+		int32 Current = Start;
+		for (int32 Step = 0; Step < Triangles.Num(); Step++)
+		{
+			const FGenTriangle& Triangle = Triangles[Current];
+			const int32 Slot = Triangle.Verts[0] == Vertex ? 0 : (Triangle.Verts[1] == Vertex ? 1 : 2);
+			const int32 Next = Triangle.Adjs[(Slot + Direction) % 3];
+			if (Next == Start)
+			{
+				return;
+			}
+			if (!Triangles.IsValidIndex(Next))
+			{
+				break;
+			}
+			Fan.Emplace(Next);
+			Current = Next;
+		}
+	}
+}
+
+void FTriangulation2D::TriangulatePseudoPolygon(int32 From, int32 To, const TArray<int32>& Chain, TArray<FGenTriangle>& Out) const
+{
+	struct FRange
+	{
+		int32 A, B, Start, End;
+	};
+
+	TArray<FRange> Stack;
+	Stack.Emplace(FRange({ From, To, 0, Chain.Num() }));
+	while (Stack.Num() > 0)
+	{
+		const FRange Range = Stack.Pop(false);
+		if (Range.Start >= Range.End)
+		{
+			continue;
+		}
+
+		// Circles through A and B are nested on the side of the chain, so a single pass finds the one that is empty
+		const FVector2D& A = Points[Range.A];
+		const FVector2D& B = Points[Range.B];
+		int32 Best = Range.Start;
+		for (int32 Index = Range.Start + 1; Index < Range.End; Index++)
+		{
+			const FVector2D& C = Points[Chain[Best]];
+			if (FGeometricPredicates::InCirclePerturbed(A, B, C, Points[Chain[Index]]) * FGeometricPredicates::Orient2D(A, B, C) > 0.0)
+			{
+				Best = Index;
+			}
+		}
+
+		const int32 C = Chain[Best];
+		if (FGeometricPredicates::Orient2D(A, B, Points[C]) > 0.0)
+		{
+			Out.Emplace(FGenTriangle(Range.A, C, Range.B));
+		}
+		else
+		{
+			Out.Emplace(FGenTriangle(Range.A, Range.B, C));
+		}
+
+		Stack.Emplace(FRange({ Range.A, C, Range.Start, Best }));
+		Stack.Emplace(FRange({ C, Range.B, Best + 1, Range.End }));
+	}
+}
+
+bool FTriangulation2D::AddConstraint(int32 From, int32 To)
+{
+	InvalidateVoronoi();
+
+	if (From == To || !Points.IsValidIndex(From) || !Points.IsValidIndex(To))
+	{
+		return false;
+	}
+
+	TArray<int32> Fan;
+	GetVertexFan(From, Fan);
+	if (Fan.Num() == 0)
+	{
+		return false;
+	}
+
+	const FVector2D& A = Points[From];
+	const FVector2D& B = Points[To];
+	const FVector2D Segment = B - A;
+
+	// Edge might already exist or pass through a neighbouring vertex
+	for (int32 Index : Fan)
+	{
+		for (int32 Vert : Triangles[Index].Verts)
+		{
+			if (Vert == To)
+			{
+				Constraints.Add(MakeEdgeKey(From, To));
+				return true;
+			}
+
+			const FVector2D Delta = Points[Vert] - A;
+			if (Vert != From && FGeometricPredicates::Orient2D(A, B, Points[Vert]) == 0.0 && (Delta | Segment) > 0.0 && Delta.SizeSquared() < Segment.SizeSquared())
+			{
+				return AddConstraint(From, Vert) && AddConstraint(Vert, To);
+			}
+		}
+	}
+
+	// Find the triangle the segment leaves through
+	int32 Current = INDEX_NONE;
+	int32 Left = INDEX_NONE;
+	int32 Right = INDEX_NONE;
+	for (int32 Index : Fan)
+	{
+		const FGenTriangle& Triangle = Triangles[Index];
+		const int32 Slot = Triangle.Verts[0] == From ? 0 : (Triangle.Verts[1] == From ? 1 : 2);
+		const int32 P = Triangle.Verts[(Slot + 1) % 3];
+		const int32 Q = Triangle.Verts[(Slot + 2) % 3];
+		const double OrientP = FGeometricPredicates::Orient2D(A, B, Points[P]);
+		const double OrientQ = FGeometricPredicates::Orient2D(A, B, Points[Q]);
+		if (OrientP * OrientQ < 0.0 && FGeometricPredicates::Orient2D(Points[P], Points[Q], A) * FGeometricPredicates::Orient2D(Points[P], Points[Q], B) < 0.0)
+		{
+			Current = Index;
+			Left = OrientP > 0.0 ? P : Q;
+			Right = OrientP > 0.0 ? Q : P;
+			break;
+		}
+	}
+
+	if (Current == INDEX_NONE)
+	{
+		return false;
+	}
+
+	// Walk along the segment, collecting crossed triangles and the polygon chains on either side
+	TArray<int32> Crossed = { Current };
+	TArray<int32> LeftChain = { Left };
+	TArray<int32> RightChain = { Right };
+	int32 End = To;
+	for (int32 Step = 0; Step < Triangles.Num(); Step++)
+	{
+		if (IsConstrained(Left, Right))
+		{
+			return false;
+		}
+
+		const FGenTriangle& Triangle = Triangles[Current];
+		const int32 Edge = (Triangle.Verts[0] != Left && Triangle.Verts[0] != Right) ? 0 : ((Triangle.Verts[1] != Left && Triangle.Verts[1] != Right) ? 1 : 2);
+		const int32 Next = Triangle.Adjs[Edge];
+		if (!Triangles.IsValidIndex(Next))
+		{
+			return false;
+		}
+
+		const FGenTriangle& Neighbour = Triangles[Next];
+		const int32 Vert = Neighbour.Verts[Neighbour.OppositeOf(Triangle)];
+		Crossed.Emplace(Next);
+		Current = Next;
+		if (Vert == To)
+		{
+			break;
+		}
+
+		// Segment passes through a vertex, continue from there afterwards
+		const double Orient = FGeometricPredicates::Orient2D(A, B, Points[Vert]);
+		if (Orient == 0.0)
+		{
+			End = Vert;
+			break;
+		}
+
+		if (Orient > 0.0)
+		{
+			LeftChain.Emplace(Vert);
+			Left = Vert;
+		}
+		else
+		{
+			RightChain.Emplace(Vert);
+			Right = Vert;
+		}
+	}
+
+	// Remember what surrounds the cavity
+	TMap<uint64, int32> Outer;
+	for (int32 Index : Crossed)
+	{
+		const FGenTriangle& Triangle = Triangles[Index];
+		for (int32 Edge = 0; Edge < 3; Edge++)
+		{
+			if (!Crossed.Contains(Triangle.Adjs[Edge]))
+			{
+				Outer.Emplace(MakeEdgeKey(Triangle.Verts[(Edge + 1) % 3], Triangle.Verts[(Edge + 2) % 3]), Triangle.Adjs[Edge]);
+			}
+		}
+	}
+
+	TArray<FGenTriangle> Cavity;
+	TriangulatePseudoPolygon(From, End, LeftChain, Cavity);
+	TriangulatePseudoPolygon(From, End, RightChain, Cavity);
+	check(Cavity.Num() == Crossed.Num());
+
+	// Reuse the crossed slots and link new triangles among each other and to the surrounding ones
+	TMap<uint64, FGenTriangleEdge> Inner;
+	for (int32 Index = 0; Index < Crossed.Num(); Index++)
+	{
+		const int32 Slot = Crossed[Index];
+		FGenTriangle& Triangle = Triangles[Slot] = Cavity[Index];
+		for (int32 Edge = 0; Edge < 3; Edge++)
+		{
+			const int32 U = Triangle.Verts[(Edge + 1) % 3];
+			const int32 V = Triangle.Verts[(Edge + 2) % 3];
+			const uint64 Key = MakeEdgeKey(U, V);
+			if (const int32* Adj = Outer.Find(Key))
+			{
+				Triangle.Adjs[Edge] = *Adj;
+				if (Triangles.IsValidIndex(*Adj))
+				{
+					FGenTriangle& Other = Triangles[*Adj];
+					Other.Adjs[Other.OppositeOf(Triangle)] = Slot;
+				}
+			}
+			else if (const FGenTriangleEdge* Twin = Inner.Find(Key))
+			{
+				Triangle.Adjs[Edge] = Twin->T;
+				Triangles[Twin->T].Adjs[Twin->E] = Slot;
+			}
+			else
+			{
+				Inner.Emplace(Key, FGenTriangleEdge(Slot, Edge));
+			}
+		}
+	}
+
+	Constraints.Add(MakeEdgeKey(From, End));
+	return End == To || AddConstraint(End, To);
+}
+
+bool FTriangulation2D::AddHole(const TArray<int32>& Loop, ETriangulationHoleError* OutError)
+{
+	InvalidateVoronoi();
+
+	ETriangulationHoleError Dummy;
+	ETriangulationHoleError& Error = OutError ? *OutError : Dummy;
+	Error = ETriangulationHoleError::None;
+
+	const int32 Num = Loop.Num();
+	if (Num < 3)
+	{
+		Error = ETriangulationHoleError::Degenerate;
+		return false;
+	}
+
+	TArray<int32> Fan;
+	for (int32 Vertex : Loop)
+	{
+		if (!Points.IsValidIndex(Vertex) || (GetVertexFan(Vertex, Fan), Fan.Num() == 0))
+		{
+			Error = ETriangulationHoleError::OutsideDomain;
+			return false;
+		}
+	}
+
+	// Reject loops touching themselves up front, the flood fill would leak through them
+	for (int32 Index = 0; Index < Num; Index++)
+	{
+		const FVector2D& A = Points[Loop[Index]];
+		const FVector2D& B = Points[Loop[(Index + 1) % Num]];
+		for (int32 Other = Index + 1; Other < Num; Other++)
+		{
+			const FVector2D& C = Points[Loop[Other]];
+			const FVector2D& D = Points[Loop[(Other + 1) % Num]];
+			if (Loop[Index] == Loop[Other])
+			{
+				Error = ETriangulationHoleError::SelfIntersecting;
+				return false;
+			}
+
+			// Neighbouring edges share a vertex and only overlap when folding back
+			const bool Next = Other == Index + 1;
+			const bool Prev = Index == 0 && Other == Num - 1;
+			if (Next || Prev)
+			{
+				const FVector2D& Shared = Next ? B : A;
+				const FVector2D& Far = Next ? D : C;
+				const FVector2D& Own = Next ? A : B;
+				if (FGeometricPredicates::Orient2D(Own, Shared, Far) == 0.0 && ((Own - Shared) | (Far - Shared)) > 0.0)
+				{
+					Error = ETriangulationHoleError::SelfIntersecting;
+					return false;
+				}
+				continue;
+			}
+
+			const double C0 = FGeometricPredicates::Orient2D(A, B, C);
+			const double C1 = FGeometricPredicates::Orient2D(A, B, D);
+			const double C2 = FGeometricPredicates::Orient2D(C, D, A);
+			const double C3 = FGeometricPredicates::Orient2D(C, D, B);
+			const bool Collinear = C0 == 0.0 && C1 == 0.0;
+			if (C0 * C1 <= 0.0 && C2 * C3 <= 0.0 && (!Collinear || FBox2D(FVector2D::Min(A, B), FVector2D::Max(A, B)).Intersect(FBox2D(FVector2D::Min(C, D), FVector2D::Max(C, D)))))
+			{
+				Error = ETriangulationHoleError::SelfIntersecting;
+				return false;
+			}
+		}
+	}
+
+	// Inside is left of the loop edges for counter-clockwise loops
+	double Area = 0.0;
+	for (int32 Index = 0; Index < Num; Index++)
+	{
+		Area += Points[Loop[Index]] ^ Points[Loop[(Index + 1) % Num]];
+	}
+
+	if (Area == 0.0)
+	{
+		Error = ETriangulationHoleError::Degenerate;
+		return false;
+	}
+
+	// Constraints split at vertices on the way, so remember the whole set to roll back to
+	TSet<uint64> Previous = Constraints;
+	for (int32 Index = 0; Index < Num; Index++)
+	{
+		const int32 From = Loop[Index];
+		const int32 To = Loop[(Index + 1) % Num];
+		if (!AddConstraint(From, To))
+		{
+			// Tell crossing an older constraint apart from running off the triangulation
+			Error = ETriangulationHoleError::OutsideDomain;
+			for (uint64 Key : Previous)
+			{
+				const FVector2D& C = Points[(int32)(Key >> 32)];
+				const FVector2D& D = Points[(int32)(Key & 0xFFFFFFFF)];
+				const double C0 = FGeometricPredicates::Orient2D(Points[From], Points[To], C);
+				const double C1 = FGeometricPredicates::Orient2D(Points[From], Points[To], D);
+				const double C2 = FGeometricPredicates::Orient2D(C, D, Points[From]);
+				const double C3 = FGeometricPredicates::Orient2D(C, D, Points[To]);
+				if (C0 * C1 < 0.0 && C2 * C3 < 0.0)
+				{
+					Error = ETriangulationHoleError::CrossesConstraint;
+					break;
+				}
+			}
+
+			// Edges forced in for the loop no longer have a constraint to justify them, failures are rare so simply legalize everything
+			Constraints = MoveTemp(Previous);
+			TArray<FGenTriangleEdge> FlipStack;
+			for (int32 Triangle = 0; Triangle < Triangles.Num(); Triangle++)
+			{
+				if (!Triangles[Triangle].IsFreeSlot())
+				{
+					for (int32 Edge = 0; Edge < 3; Edge++)
+					{
+						FlipStack.Emplace(FGenTriangleEdge(Triangle, Edge));
+					}
+				}
+			}
+			LegalizeEdges(FlipStack, nullptr, true);
+			return false;
+		}
+	}
+
+	// Seed with the triangles right inside of each loop edge
+	TArray<int32> Stack;
+	for (int32 Index = 0; Index < Num; Index++)
+	{
+		const int32 From = Loop[Index];
+		const FVector2D& A = Points[From];
+		const FVector2D& B = Points[Loop[(Index + 1) % Num]];
+
+		GetVertexFan(From, Fan);
+		for (int32 Triangle : Fan)
+		{
+			for (int32 Vert : Triangles[Triangle].Verts)
+			{
+				const double Orient = FGeometricPredicates::Orient2D(A, B, Points[Vert]);
+				if (Vert != From && IsConstrained(From, Vert) && Orient == 0.0 && ((Points[Vert] - A) | (B - A)) > 0.0)
+				{
+					for (int32 Other : Triangles[Triangle].Verts)
+					{
+						if (FGeometricPredicates::Orient2D(A, B, Points[Other]) * Area > 0.0)
+						{
+							Stack.Emplace(Triangle);
+						}
+					}
+				}
+			}
+		}
+	}
+
+	// Flood fill up to the constraints
+	TBitArray<> Removed(false, Triangles.Num());
+	while (Stack.Num() > 0)
+	{
+		const int32 Index = Stack.Pop(false);
+		if (Removed[Index])
+		{
+			continue;
+		}
+		Removed[Index] = true;
+
+		const FGenTriangle& Triangle = Triangles[Index];
+		for (int32 Edge = 0; Edge < 3; Edge++)
+		{
+			const int32 Adj = Triangle.Adjs[Edge];
+			if (Triangles.IsValidIndex(Adj) && !Removed[Adj] && !IsConstrained(Triangle.Verts[(Edge + 1) % 3], Triangle.Verts[(Edge + 2) % 3]))
+			{
+				Stack.Emplace(Adj);
+			}
+		}
+	}
+
+	CompactTriangles(Removed);
+	return true;
+}
+
+void FTriangulation2D::CompactTriangles(const TBitArray<>& Removed)
+{
+	TArray<int32> Remap;
+	Remap.SetNumUninitialized(Triangles.Num());
+
+	int32 Count = 0;
+	for (int32 Index = 0; Index < Triangles.Num(); Index++)
+	{
+		Remap[Index] = (Removed[Index] || Triangles[Index].IsFreeSlot()) ? INDEX_NONE : Count++;
+	}
+
+	for (int32 Index = 0; Index < Triangles.Num(); Index++)
+	{
+		if (Remap[Index] != INDEX_NONE)
+		{
+			FGenTriangle& Triangle = Triangles[Remap[Index]] = Triangles[Index];
+			for (int32& Adj : Triangle.Adjs)
+			{
+				if (Adj != INDEX_NONE)
+				{
+					Adj = Remap[Adj];
+				}
+			}
+		}
+	}
+
+	Triangles.SetNum(Count);
+	FreeTriangles.Reset();
+	ResetLocation();
+	InvalidateVoronoi();
+}
+
+int32 FTriangulation2D::AllocateTriangle()
+{
+	if (FreeTriangles.Num() > 0)
+	{
+		return FreeTriangles.Pop(false);
+	}
+	return Triangles.Emplace();
+}
+
+bool FTriangulation2D::Refine(double MinAngle, TFunctionRef<double(const FVector2D&)> MaxEdgeLength, int32 MaxTriangles)
+{
+	ANGRY_TRIANGULATION_SCOPE(Refine);
+
+	// A triangle's smallest angle is MinAngle where its circumradius is 1 / (2 sin MinAngle) times its shortest edge, refinement isn't guaranteed to end past 30 degrees
+	const double AngleScale = (MinAngle > 0.0) ? 2.0 * FMath::Sin(FMath::DegreesToRadians(FMath::Min(MinAngle, 30.0))) : 0.0;
+
+	// Above one for triangles that need refinement
+	const auto GetBadness = [&](int32 Index) -> double
+	{
+		const FGenTriangle& Triangle = Triangles[Index];
+		if (Triangle.IsFreeSlot() || !Triangle.Enabled)
+		{
+			return 0.0;
+		}
+
+		const FVector2D& A = Points[Triangle.Verts[0]];
+		const FVector2D& B = Points[Triangle.Verts[1]];
+		const FVector2D& C = Points[Triangle.Verts[2]];
+		const double AB = (B - A).SizeSquared();
+		const double BC = (C - B).SizeSquared();
+		const double CA = (A - C).SizeSquared();
+		const double Area = FMath::Abs((B - A) ^ (C - A));
+		if (Area <= 0.0)
+		{
+			return 0.0;
+		}
+
+		// Circumradius is the product of the edges over four times the area, Area is twice the area
+		const double Ratio = FMath::Sqrt(AB * BC * CA) / (2.0 * Area * FMath::Sqrt(FMath::Min3(AB, BC, CA)));
+		const double MaxLength = MaxEdgeLength((A + B + C) / 3.0);
+		const double Length = (MaxLength > 0.0) ? FMath::Sqrt(FMath::Max3(AB, BC, CA)) / MaxLength : 0.0;
+		return FMath::Max(Ratio * AngleScale, Length);
+	};
+
+	typedef TPair<double, int32> FBadTriangle;
+	const auto Worse = [](const FBadTriangle& A, const FBadTriangle& B) { return A.Key > B.Key; };
+	TArray<FBadTriangle> Queue;
+
+	// Border and constrained edges are segments, a segment with a vertex or circumcenter inside of its diametral circle is split at its midpoint.
+	// Without encroached segments every circumcenter lies inside of the domain
+	TSet<uint64> Segments;
+	Segments.Append(Constraints);
+	TArray<uint64> Encroached;
+	const auto IsEncroached = [&](uint64 Key, const FVector2D& Point) -> bool
+	{
+		return ((Points[(int32)(Key >> 32)] - Point) | (Points[(int32)(Key & 0xFFFFFFFF)] - Point)) < 0.0;
+	};
+
+	// Queues a triangle if it is bad and its segments if the opposite vertex encroaches on them, enough to find all encroachment on a constrained Delaunay triangulation.
+	// Holes are bounded by constraints, their triangles never encroach
+	const auto Visit = [&](int32 Index)
+	{
+		const FGenTriangle& Triangle = Triangles[Index];
+		if (!Triangle.Enabled)
+		{
+			return;
+		}
+
+		for (int32 Edge = 0; Edge < 3; Edge++)
+		{
+			const int32 From = Triangle.Verts[(Edge + 1) % 3];
+			const int32 To = Triangle.Verts[(Edge + 2) % 3];
+			const uint64 Key = MakeEdgeKey(From, To);
+			if (Triangle.Adjs[Edge] == INDEX_NONE || IsConstrained(From, To))
+			{
+				Segments.Add(Key);
+				if (IsEncroached(Key, Points[Triangle.Verts[Edge]]))
+				{
+					Encroached.Emplace(Key);
+				}
+			}
+		}
+
+		const double Badness = GetBadness(Index);
+		if (Badness > 1.0)
+		{
+			Queue.HeapPush(FBadTriangle(Badness, Index), Worse);
+		}
+	};
+
+	for (int32 Index = 0; Index < Triangles.Num(); Index++)
+	{
+		if (!Triangles[Index].IsFreeSlot())
+		{
+			Visit(Index);
+		}
+	}
+
+	TArray<FGenTriangleEdge> FlipStack;
+	TArray<int32> Fan;
+	TArray<int32> Cavity;
+	const auto VisitFan = [&](int32 Vertex)
+	{
+		GetVertexFan(Vertex, Fan);
+		for (int32 Index : Fan)
+		{
+			Visit(Index);
+		}
+	};
+
+	const auto SplitSegment = [&](uint64 Key) -> bool
+	{
+		const int32 From = (int32)(Key >> 32);
+		const int32 To = (int32)(Key & 0xFFFFFFFF);
+
+		int32 Owner = INDEX_NONE;
+		int32 OwnerEdge = INDEX_NONE;
+		GetVertexFan(From, Fan);
+		for (int32 Index : Fan)
+		{
+			const FGenTriangle& Triangle = Triangles[Index];
+			if (Triangle.HasVertex(To))
+			{
+				Owner = Index;
+				for (int32 Vert = 0; Vert < 3; Vert++)
+				{
+					OwnerEdge = (Triangle.Verts[Vert] != From && Triangle.Verts[Vert] != To) ? Vert : OwnerEdge;
+				}
+				break;
+			}
+		}
+
+		// Segments go stale when a circumcenter lands exactly on them
+		Segments.Remove(Key);
+		if (Owner == INDEX_NONE)
+		{
+			return false;
+		}
+
+		const int32 Midpoint = Points.Emplace((Points[From] + Points[To]) * 0.5);
+		SplitEdge(Owner, OwnerEdge, Midpoint, FlipStack);
+		VisitFan(Midpoint);
+		return true;
+	};
+
+	// Inserts add at most two triangles
+	while (Triangles.Num() - FreeTriangles.Num() + 2 <= MaxTriangles)
+	{
+		if (Encroached.Num() > 0)
+		{
+			const uint64 Key = Encroached.Pop(false);
+			if (Segments.Contains(Key))
+			{
+				SplitSegment(Key);
+			}
+			continue;
+		}
+
+		if (Queue.Num() == 0)
+		{
+			break;
+		}
+
+		FBadTriangle Bad;
+		Queue.HeapPop(Bad, Worse, false);
+
+		// Entries go stale once their slot is flipped or split, only refine what is still bad
+		if (GetBadness(Bad.Value) <= 1.0) continue;
+
+		FVector2D Center;
+		double Radius;
+		Circumcenter(Bad.Value, Center, Radius);
+		if (Radius == 0.0) continue;
+
+		// With no vertex encroaching, a segment the circumcenter encroaches on would border its cavity: the triangles whose circumcircle contains it,
+		// reached from the bad triangle without crossing a segment. That includes the segment between the triangle and a circumcenter it can't see
+		uint64 Segment = 0;
+		bool Encroaches = false;
+		Cavity.Reset();
+		Cavity.Emplace(Bad.Value);
+		for (int32 Next = 0; Next < Cavity.Num() && !Encroaches; Next++)
+		{
+			const FGenTriangle& Triangle = Triangles[Cavity[Next]];
+			for (int32 Edge = 0; Edge < 3; Edge++)
+			{
+				const int32 From = Triangle.Verts[(Edge + 1) % 3];
+				const int32 To = Triangle.Verts[(Edge + 2) % 3];
+				const int32 Adj = Triangle.Adjs[Edge];
+				if (Adj == INDEX_NONE || IsConstrained(From, To))
+				{
+					Segment = MakeEdgeKey(From, To);
+					if (IsEncroached(Segment, Center))
+					{
+						Encroaches = true;
+						break;
+					}
+					continue;
+				}
+
+				FVector2D AdjCenter;
+				double AdjRadius;
+				Circumcenter(Adj, AdjCenter, AdjRadius);
+				if ((AdjCenter - Center).SizeSquared() < AdjRadius && !Cavity.Contains(Adj))
+				{
+					Cavity.Emplace(Adj);
+				}
+			}
+		}
+
+		if (Encroaches)
+		{
+			SplitSegment(Segment);
+			Visit(Bad.Value);
+			continue;
+		}
+
+		const int32 PointIndex = Points.Emplace(Center);
+		if (InsertVertex(PointIndex, FlipStack) != PointIndex)
+		{
+			// On top of a vertex or outside of the domain, the triangle stays as it is
+			Points.Pop(false);
+			continue;
+		}
+		VisitFan(PointIndex);
+	}
+
+	for (int32 Index = 0; Index < Triangles.Num(); Index++)
+	{
+		if (GetBadness(Index) > 1.0)
+		{
+			return false;
+		}
+	}
+	return true;
+}
+
+bool FTriangulation2D::RemovePoint(int32 Vertex)
+{
+	InvalidateVoronoi();
+
+	TArray<int32> Fan;
+	GetVertexFan(Vertex, Fan);
+	if (Fan.Num() == 0)
+	{
+		return false;
+	}
+
+	const auto SlotOf = [&](int32 Index)
+	{
+		const FGenTriangle& Triangle = Triangles[Index];
+		return Triangle.Verts[0] == Vertex ? 0 : (Triangle.Verts[1] == Vertex ? 1 : 2);
+	};
+
+	// Rewind to the border if there is one so the fan can be walked clockwise in one go
+	int32 First = Fan[0];
+	bool Closed = false;
+	for (int32 Step = 0; Step < Fan.Num(); Step++)
+	{
+		const int32 Prev = Triangles[First].Adjs[(SlotOf(First) + 2) % 3];
+		if (!Triangles.IsValidIndex(Prev))
+		{
+			break;
+		}
+		if (Prev == Fan[0])
+		{
+			Closed = true;
+			break;
+		}
+		First = Prev;
+	}
+
+	// Link polygon around the vertex in clockwise order, each link edge remembers the triangle edge outside of it
+	struct FLinkEdge
+	{
+		int32 Triangle;
+		int32 Edge;
+	};
+
+	TArray<int32> Star;
+	TArray<int32> Link;
+	TArray<FLinkEdge> Outside;
+	int32 Current = First;
+	for (int32 Step = 0; Step < Fan.Num(); Step++)
+	{
+		const FGenTriangle& Triangle = Triangles[Current];
+		const int32 Slot = SlotOf(Current);
+		const int32 A = Triangle.Verts[(Slot + 1) % 3];
+		const int32 B = Triangle.Verts[(Slot + 2) % 3];
+		if (IsConstrained(Vertex, A) || IsConstrained(Vertex, B))
+		{
+			return false;
+		}
+
+		if (Link.Num() == 0)
+		{
+			Link.Emplace(A);
+		}
+		Link.Emplace(B);
+		Star.Emplace(Current);
+
+		const int32 Adj = Triangle.Adjs[Slot];
+		FLinkEdge Edge({ Adj, INDEX_NONE });
+		if (Triangles.IsValidIndex(Adj))
+		{
+			const FGenTriangle& Other = Triangles[Adj];
+			Edge.Edge = (Other.Verts[0] != A && Other.Verts[0] != B) ? 0 : ((Other.Verts[1] != A && Other.Verts[1] != B) ? 1 : 2);
+		}
+		Outside.Emplace(Edge);
+
+		const int32 Next = Triangle.Adjs[(Slot + 1) % 3];
+		if (!Triangles.IsValidIndex(Next) || Next == First)
+		{
+			break;
+		}
+		Current = Next;
+	}
+
+	// Last link vertex closes the loop
+	if (Closed)
+	{
+		Link.Pop(false);
+	}
+
+	TArray<int32> Created;
+	const auto Connect = [&](int32 Index, int32 Edge, const FLinkEdge& Other)
+	{
+		Triangles[Index].Adjs[Edge] = Other.Triangle;
+		if (Triangles.IsValidIndex(Other.Triangle))
+		{
+			Triangles[Other.Triangle].Adjs[Other.Edge] = Index;
+		}
+	};
+
+	// Clipping can get stuck on nearly degenerate links, keep everything it writes to so the star can be put back
+	TArray<TPair<int32, FGenTriangle>> Backup;
+	for (int32 Index : Star)
+	{
+		Backup.Emplace(Index, Triangles[Index]);
+	}
+	for (const FLinkEdge& Edge : Outside)
+	{
+		if (Triangles.IsValidIndex(Edge.Triangle))
+		{
+			Backup.Emplace(Edge.Triangle, Triangles[Edge.Triangle]);
+		}
+	}
+	const int32 TriangleNum = Triangles.Num();
+
+	// Clip ears whose circumcircle holds no other link vertex, they are Delaunay in the final triangulation.
+	// An open fan around a hull vertex stops once the remaining chain is convex, it becomes the new border
+	bool Stuck = false;
+	while (Link.Num() >= 3)
+	{
+		const int32 Num = Link.Num();
+		const int32 Ears = Closed ? Num : Num - 2;
+		int32 Ear = INDEX_NONE;
+		int32 Fallback = INDEX_NONE;
+		bool Convex = false;
+		for (int32 Candidate = 0; Candidate < Ears && Ear == INDEX_NONE; Candidate++)
+		{
+			const int32 Middle = (Candidate + 1) % Num;
+			const int32 Last = (Candidate + 2) % Num;
+			const FVector2D& A = Points[Link[Candidate]];
+			const FVector2D& B = Points[Link[Middle]];
+			const FVector2D& C = Points[Link[Last]];
+			if (FGeometricPredicates::Orient2D(A, B, C) >= 0.0)
+			{
+				continue;
+			}
+			Convex = true;
+
+			// Plain ears without other vertices inside are kept in case precision leaves no Delaunay ear
+			bool Empty = true;
+			bool Inside = false;
+			for (int32 Other = 0; Other < Num; Other++)
+			{
+				if (Other != Candidate && Other != Middle && Other != Last)
+				{
+					const FVector2D& D = Points[Link[Other]];
+					Empty &= !InsideCircumcircle(A, B, C, D);
+					Inside |= FGeometricPredicates::Orient2D(A, B, D) <= 0.0 && FGeometricPredicates::Orient2D(B, C, D) <= 0.0 && FGeometricPredicates::Orient2D(C, A, D) <= 0.0;
+				}
+			}
+
+			if (Empty)
+			{
+				Ear = Candidate;
+			}
+			else if (!Inside && Fallback == INDEX_NONE)
+			{
+				Fallback = Candidate;
+			}
+		}
+
+		if (Ear == INDEX_NONE)
 		{
-			if (Check[Edge] < SMALL_NUMBER)
+			Ear = Fallback;
+			if (Ear == INDEX_NONE)
 			{
-				TArray<int32> TriangleIndices;
+				// Only a reflex open chain is a valid end, anything else would leave a hole
+				Stuck = Closed || Convex;
+				break;
+			}
+		}
 
-				// Cut neighbour if available
-				const int32 OppIndex = Center.Adjs[Edge];
-				if (Triangles.IsValidIndex(OppIndex))
-				{
-					const FGenTriangle& Opp = Triangles[OppIndex];
-					const int32 OppEdge = Opp.OppositeOf(Center);
-					const int32 OppNew = CutEdge(OppIndex, CenterIndex, OppEdge, PointIndex);
-					TriangleIndices.Append({ OppIndex, OppNew });
-				}
+		// Reuse star slots before taking free ones
+		const int32 Index = (Created.Num() < Star.Num()) ? Star[Created.Num()] : AllocateTriangle();
+		Created.Emplace(Index);
 
-				const int32 New = CutEdge(CenterIndex, OppIndex, Edge, PointIndex);
-				TriangleIndices.Append({ CenterIndex, New });
+		const int32 Middle = (Ear + 1) % Num;
+		const int32 Last = (Ear + 2) % Num;
+		Triangles[Index] = FGenTriangle(Link[Ear], Link[Middle], Link[Last]);
 
-				Reparent(TriangleIndices);
-				return;
-			}
+		const bool Final = Closed && Num == 3;
+		Connect(Index, 2, Outside[Ear]);
+		Connect(Index, 0, Outside[Middle]);
+		if (Final)
+		{
+			Connect(Index, 1, Outside[Last]);
+			break;
 		}
 
-		// Hook up vertices and ajdacency lists
-		FGenTriangle Left(Center);
-		FGenTriangle Right(Center);
+		// The ear's diagonal replaces its two link edges
+		Outside[Ear] = FLinkEdge({ Index, 1 });
+		Triangles[Index].Adjs[1] = INDEX_NONE;
+		Link.RemoveAt(Middle);
+		Outside.RemoveAt(Middle);
+	}
 
-		Center.Verts[0] = PointIndex;
-		Right.Verts[1] = PointIndex;
-		Left.Verts[2] = PointIndex;
+	if (Stuck)
+	{
+		for (int32 Index = Star.Num(); Index < Created.Num(); Index++)
+		{
+			if (Created[Index] < TriangleNum)
+			{
+				FGenTriangle& Triangle = Triangles[Created[Index]];
+				Triangle = FGenTriangle();
+				Triangle.Enabled = false;
+				FreeTriangles.Emplace(Created[Index]);
+			}
+		}
+		Triangles.SetNum(TriangleNum, false);
 
-		const int32 RightIndex = Triangles.Emplace(Right);
-		const int32 LeftIndex = Triangles.Emplace(Left);
+		for (const TPair<int32, FGenTriangle>& Pair : Backup)
+		{
+			Triangles[Pair.Key] = Pair.Value;
+		}
+		return false;
+	}
 
-		Reparent({ CenterIndex, LeftIndex, RightIndex });
-		return;
+	// Whatever is left of an open chain is the new border
+	if (!Closed)
+	{
+		for (const FLinkEdge& Edge : Outside)
+		{
+			if (Triangles.IsValidIndex(Edge.Triangle))
+			{
+				Triangles[Edge.Triangle].Adjs[Edge.Edge] = INDEX_NONE;
+			}
+		}
+	}
+
+	// Slots the new triangles didn't need are released
+	for (int32 Index = Created.Num(); Index < Star.Num(); Index++)
+	{
+		FGenTriangle& Triangle = Triangles[Star[Index]];
+		Triangle = FGenTriangle();
+		Triangle.Enabled = false;
+		FreeTriangles.Emplace(Star[Index]);
 	}
+
+	LastTriangle = (Created.Num() > 0) ? Created[0] : INDEX_NONE;
+	return true;
 }
 
+bool FTriangulation2D::MovePoints(TArrayView<const FVector2D> Targets)
+{
+	TArray<int32> Vertices;
+	Vertices.SetNumUninitialized(FMath::Min(Targets.Num(), Points.Num()));
+	for (int32 Index = 0; Index < Vertices.Num(); Index++)
+	{
+		Vertices[Index] = Index;
+	}
+	return MovePoints(Vertices, Targets.Slice(0, Vertices.Num()));
+}
 
-void FTriangulation2D::QHull(TArray<FVector2D> Cloud, int32 Iterations)
+bool FTriangulation2D::MovePoints(TArrayView<const int32> Vertices, TArrayView<const FVector2D> Targets)
 {
-	Points.Empty();
-	Triangles.Empty();
-	if (Cloud.Num() > 2)
+	ANGRY_TRIANGULATION_SCOPE(MovePoints);
+
+	InvalidateVoronoi();
+
+	check(Vertices.Num() == Targets.Num());
+
+	bool Success = true;
+	TArray<int32> Outside;
+	TArray<int32> Fan;
+	TArray<FGenTriangleEdge> FlipStack;
+
+	// Any triangle per vertex to start fan walks from, flips can make entries stale which the walk checks for.
+	// Few vertices are cheaper to find by walking than by touching every triangle
+	TArray<int32> VertexTriangle;
+	VertexTriangle.Init(INDEX_NONE, Points.Num());
+	if (Vertices.Num() * 64 >= Triangles.Num())
 	{
-		FVector2D Mean = FVector2D::ZeroVector;
-		for (const FVector2D& Point : Cloud)
+		for (int32 Index = 0; Index < Triangles.Num(); Index++)
 		{
-			Mean += Point;
+			const FGenTriangle& Triangle = Triangles[Index];
+			if (Triangle.IsFreeSlot()) continue;
+
+			for (int32 Vert : Triangle.Verts)
+			{
+				VertexTriangle[Vert] = Index;
+			}
 		}
-		Mean /= Cloud.Num();
+	}
 
-		// Get closest point to mean
-		Cloud.Sort([Mean](const FVector2D& A, const FVector2D& B) -> bool { return (A - Mean).SizeSquared() > (B - Mean).SizeSquared(); });
-		const FVector2D P0 = Cloud.Pop();
+	// Rotates around a hull vertex to its border edge, direction 1 returns the previous and 2 the next vertex along the hull
+	const auto HullNeighbour = [&](int32 Triangle, int32 Vert, int32 Direction) -> int32
+	{
+		for (int32 Step = 0; Step < Triangles.Num(); Step++)
+		{
+			const FGenTriangle& Current = Triangles[Triangle];
+			const int32 Slot = Current.Verts[0] == Vert ? 0 : (Current.Verts[1] == Vert ? 1 : 2);
+			const int32 Next = Current.Adjs[(Slot + Direction) % 3];
+			if (!Triangles.IsValidIndex(Next))
+			{
+				return Current.Verts[(Slot + 3 - Direction) % 3];
+			}
+			Triangle = Next;
+		}
+		return INDEX_NONE;
+	};
 
-		// Get next closest point
-		Cloud.Sort([P0](const FVector2D& A, const FVector2D& B) -> bool { return (A - P0).SizeSquared() > (B - P0).SizeSquared(); });
-		const FVector2D P1 = Cloud.Pop();
+	const bool Convex = Constraints.Num() == 0;
+	for (int32 Index = 0; Index < Vertices.Num(); Index++)
+	{
+		const int32 Vertex = Vertices[Index];
+		const FVector2D& Target = Targets[Index];
+		if (!Points.IsValidIndex(Vertex) || Points[Vertex] == Target)
+		{
+			continue;
+		}
 
-		// Find smallest circumcircle
-		float ClosestDQ = FLT_MAX;
-		int32 Closest = Cloud.Num() - 1;
-		for (int32 Index = Closest; Index >= 0; Index--)
+		// Vertices stay in place as long as none of their triangles fold over
+		GetVertexFan(Vertex, Fan, VertexTriangle[Vertex]);
+		bool InPlace = Fan.Num() > 0;
+		bool OnHull = false;
+		int32 Hull[4] = { INDEX_NONE, INDEX_NONE, INDEX_NONE, INDEX_NONE };
+		for (int32 Triangle : Fan)
 		{
-			const FVector2D& P2 = Cloud[Index];
-			if (ClosestDQ < (P0 - P2).SizeSquared())
+			const FGenTriangle& Mine = Triangles[Triangle];
+			const int32 Slot = Mine.Verts[0] == Vertex ? 0 : (Mine.Verts[1] == Vertex ? 1 : 2);
+			const FVector2D& A = Points[Mine.Verts[(Slot + 1) % 3]];
+			const FVector2D& B = Points[Mine.Verts[(Slot + 2) % 3]];
+			InPlace &= FGeometricPredicates::Orient2D(Target, A, B) < 0.0;
+
+			// Border spokes lead to the neighbours along the hull, and from there to the ones after
+			if (!Triangles.IsValidIndex(Mine.Adjs[(Slot + 1) % 3]))
 			{
-				break;
+				OnHull = true;
+				Hull[1] = Mine.Verts[(Slot + 2) % 3];
+				Hull[0] = HullNeighbour(Triangle, Hull[1], 1);
 			}
-			
-			FVector2D Circ;
-			if (UTriangleMath::ComputeCircumcenter2D(P0, P1, P2, Circ))
+			if (!Triangles.IsValidIndex(Mine.Adjs[(Slot + 2) % 3]))
 			{
-				const float CQ = (Circ - P2).SizeSquared();
-				if (CQ < ClosestDQ)
+				OnHull = true;
+				Hull[2] = Mine.Verts[(Slot + 1) % 3];
+				Hull[3] = HullNeighbour(Triangle, Hull[2], 2);
+			}
+		}
+
+		// Hull vertices also have to keep the hull convex at themselves and both neighbours, without wrapping their fan around anything
+		if (InPlace && OnHull)
+		{
+			InPlace = Convex && Hull[0] != INDEX_NONE && Hull[3] != INDEX_NONE;
+			InPlace = InPlace &&
+				FGeometricPredicates::Orient2D(Points[Hull[0]], Points[Hull[1]], Target) <= 0.0 &&
+				FGeometricPredicates::Orient2D(Points[Hull[1]], Target, Points[Hull[2]]) <= 0.0 &&
+				FGeometricPredicates::Orient2D(Target, Points[Hull[2]], Points[Hull[3]]) <= 0.0;
+
+			// Spokes turn clockwise from the next to the previous hull vertex, keeping all of them inside that wedge stops the fan from wrapping around
+			for (int32 Triangle : Fan)
+			{
+				const FGenTriangle& Mine = Triangles[Triangle];
+				const int32 Slot = Mine.Verts[0] == Vertex ? 0 : (Mine.Verts[1] == Vertex ? 1 : 2);
+				const int32 Spoke = Mine.Verts[(Slot + 2) % 3];
+				if (InPlace && Spoke != Hull[1])
 				{
-					ClosestDQ = CQ;
-					Closest = Index;
+					InPlace = FGeometricPredicates::Orient2D(Target, Points[Hull[2]], Points[Spoke]) < 0.0 && FGeometricPredicates::Orient2D(Target, Points[Spoke], Points[Hull[1]]) < 0.0;
 				}
 			}
 		}
 
-		if (!Cloud.IsValidIndex(Closest))
+		if (InPlace)
 		{
-			return;
+			// Only edges of the star can have become illegal
+			Points[Vertex] = Target;
+			for (int32 Triangle : Fan)
+			{
+				const FGenTriangle& Mine = Triangles[Triangle];
+				const int32 Slot = Mine.Verts[0] == Vertex ? 0 : (Mine.Verts[1] == Vertex ? 1 : 2);
+				FlipStack.Emplace(FGenTriangleEdge(Triangle, Slot));
+				FlipStack.Emplace(FGenTriangleEdge(Triangle, (Slot + 1) % 3));
+			}
+			LegalizeEdges(FlipStack, nullptr, true);
+			continue;
 		}
 
-		// Create Triangle
-		const FVector2D P2 = Cloud[Closest];
-		Cloud.RemoveAt(Closest);
+		// Vertex left its star, take it out and insert it again under the same index
+		if (Fan.Num() > 0 && !RemovePoint(Vertex))
+		{
+			Success = false;
+			continue;
+		}
 
-		if (((P2 - P0) ^ (P1 - P0)) < 0.0f)
+		// Hull vertices most likely stay outside, holes would look like border from the inside so only without constraints.
+		// The old hull neighbours are still on the hull and give the walk a start, interior vertices have to search for one
+		Points[Vertex] = Target;
+		const int32 HullVertex = OnHull ? (Hull[1] != INDEX_NONE ? Hull[1] : Hull[2]) : INDEX_NONE;
+		int32 Inserted = (Convex && OnHull) ? ExtendHull(Vertex, HullVertex) : INDEX_NONE;
+		if (Inserted == INDEX_NONE)
 		{
-			Points.Append({ P1, P0, P2 });
+			Inserted = InsertVertex(Vertex);
 		}
-		else
+		if (Inserted == INDEX_NONE && Convex && !OnHull)
 		{
-			Points.Append({ P2, P0, P1 });
+			Inserted = ExtendHull(Vertex, INDEX_NONE);
 		}
-		const int32 CT = Triangles.Emplace(FGenTriangle(0, 1, 2));
-
-		// Create convex hull
-		TArray<FGenTriangleEdge> Convex;
-		Convex.Emplace(FGenTriangleEdge(CT, 0));
-		Convex.Emplace(FGenTriangleEdge(CT, 1));
-		Convex.Emplace(FGenTriangleEdge(CT, 2));
+		if (Inserted == INDEX_NONE)
+		{
+			Outside.Emplace(Vertex);
+		}
+		else if (Inserted != Vertex)
+		{
+			// Landed on another vertex, two indices can't share a position so this one stays unconnected
+			Success = false;
+		}
+	}
 
-		// Sort points away from circumcircle
-		FVector2D Circ;
-		UTriangleMath::ComputeCircumcenter2D(P0, P1, P2, Circ);
-		Cloud.Sort([Circ](const FVector2D& A, const FVector2D& B) -> bool { return (A - Circ).SizeSquared() > (B - Circ).SizeSquared(); });
+	// Targets outside the triangulated area need a new hull. Constraints and disabled triangles would be lost so those vertices stay unconnected instead
+	if (Outside.Num() > 0)
+	{
+		if (Constraints.Num() > 0 || Triangles.ContainsByPredicate([](const FGenTriangle& Triangle) { return !Triangle.IsFreeSlot() && !Triangle.Enabled; }))
+		{
+			return false;
+		}
 
-		while (Cloud.Num() > 0 && Iterations-- != 0) //for (int32 N = 0; N < 2; N++) //
+		// Only vertices still connected and the ones that couldn't be inserted, removed and unconnected vertices stay out under their index
+		TBitArray<> Keep(false, Points.Num());
+		for (const FGenTriangle& Triangle : Triangles)
 		{
-			const FVector2D Point = Cloud.Pop();
-			const int32 PointIndex = Points.Emplace(Point);
+			if (Triangle.IsFreeSlot()) continue;
 
-			// Find range of visible edges
-			bool IsVisible = false;
-			int32 Start = 0, Count = 0;
-			const int32 Num = Convex.Num();
-			for (int32 Index = 0; Index < Num; Index++)
+			for (int32 Vert : Triangle.Verts)
 			{
-				// Get edge vector
-				const FGenTriangleEdge& Edge = Convex[Index];
-				const int32 Prev = Triangles[Edge.T].Verts[(Edge.E + 1) % 3];
-				const int32 Next = Triangles[Edge.T].Verts[(Edge.E + 2) % 3];
+				Keep[Vert] = true;
+			}
+		}
+		for (int32 Vertex : Outside)
+		{
+			Keep[Vertex] = true;
+		}
 
-				// see whether convex hull is visible to Point
-				const float Cross = (Points[Next] - Points[Prev]) ^ (Point - Points[Prev]);
-				if (Cross < 0.000001f)
-				{
-					IsVisible = false;
-				}
-				else
-				{
-					if (!IsVisible)
-					{
-						Start = Index;
-						IsVisible = true;
-					}
-					Count++;
-				}
+		TArray<int32> Remap;
+		TArray<FVector2D> Cloud;
+		for (int32 Index = 0; Index < Points.Num(); Index++)
+		{
+			if (Keep[Index])
+			{
+				Remap.Emplace(Index);
+				Cloud.Emplace(Points[Index]);
 			}
+		}
+
+		TArray<FVector2D> AllPoints = Points;
+		QHull(MoveTemp(Cloud), -1, true);
+		for (FGenTriangle& Triangle : Triangles)
+		{
+			if (Triangle.IsFreeSlot()) continue;
 
-			// Construct triangles
-			TArray<FGenTriangleEdge> NewConvex;
-			for (int32 Index = 0; Index < Num; Index++)
+			for (int32& Vert : Triangle.Verts)
 			{
-				const FGenTriangleEdge& Edge = Convex[(Start + Index) % Num];
-				if (Index < Count)
-				{
-					// Chain new triangles
-					const int32 Prev = Triangles[Edge.T].Verts[(Edge.E + 1) % 3];
-					const int32 Next = Triangles[Edge.T].Verts[(Edge.E + 2) % 3];
+				Vert = Remap[Vert];
+			}
+		}
+		Points = MoveTemp(AllPoints);
+		ResetLocation();
+		Success &= Triangles.Num() > 0;
+	}
+	return Success;
+}
 
-					FGenTriangle Triangle(Prev, PointIndex, Next);
-					Triangle.Adjs[0] = INDEX_NONE;
-					Triangle.Adjs[1] = Edge.T;
-					Triangle.Adjs[2] = INDEX_NONE;
+void FTriangulation2D::Compact()
+{
+	TBitArray<> Removed(false, Triangles.Num());
+	for (int32 Index = 0; Index < Triangles.Num(); Index++)
+	{
+		Removed[Index] = !Triangles[Index].Enabled;
+	}
+	CompactTriangles(Removed);
 
-					const int32 TriangleIndex = Triangles.Emplace(Triangle);
-					Triangles[Edge.T].Adjs[Edge.E] = TriangleIndex;
+	TArray<int32> Remap;
+	Remap.Init(INDEX_NONE, Points.Num());
+	for (const FGenTriangle& Triangle : Triangles)
+	{
+		for (int32 Vert : Triangle.Verts)
+		{
+			Remap[Vert] = 0;
+		}
+	}
 
-					if (Index == 0)
-					{
-						NewConvex.Emplace(FGenTriangleEdge(TriangleIndex, 2));
-					}
-					else
-					{
-						Triangles[TriangleIndex].Adjs[2] = TriangleIndex - 1;
-					}
+	int32 Count = 0;
+	for (int32 Index = 0; Index < Points.Num(); Index++)
+	{
+		if (Remap[Index] != INDEX_NONE)
+		{
+			Remap[Index] = Count;
+			Points[Count++] = Points[Index];
+		}
+	}
+	Points.SetNum(Count);
 
-					if (Index == Count-1)
-					{
-						NewConvex.Emplace(FGenTriangleEdge(TriangleIndex, 0));
-					}
-					else
-					{
-						Triangles[TriangleIndex].Adjs[0] = TriangleIndex + 1;
-					}
-				}
-				else
+	for (FGenTriangle& Triangle : Triangles)
+	{
+		for (int32& Vert : Triangle.Verts)
+		{
+			Vert = Remap[Vert];
+		}
+	}
+
+	// Constraints on removed vertices go with them
+	TSet<uint64> Remapped;
+	for (uint64 Key : Constraints)
+	{
+		const int32 From = Remap[(int32)(Key >> 32)];
+		const int32 To = Remap[(int32)(Key & 0xFFFFFFFF)];
+		if (From != INDEX_NONE && To != INDEX_NONE)
+		{
+			Remapped.Add(MakeEdgeKey(From, To));
+		}
+	}
+	Constraints = MoveTemp(Remapped);
+}
+
+void FTriangulation2D::Reset()
+{
+	Points.Reset();
+	Triangles.Reset();
+	Constraints.Reset();
+	FreeTriangles.Reset();
+	ResetLocation();
+	InvalidateVoronoi();
+}
+
+bool FTriangulation2D::Validate(bool Delaunay) const
+{
+	const int32 Num = Triangles.Num();
+	for (int32 Index = 0; Index < Num; Index++)
+	{
+		const FGenTriangle& Triangle = Triangles[Index];
+		if (Triangle.IsFreeSlot()) continue;
+
+		for (int32 Vert = 0; Vert < 3; Vert++)
+		{
+			if (!Points.IsValidIndex(Triangle.Verts[Vert]) || Triangle.Verts[Vert] == Triangle.Verts[(Vert + 1) % 3])
+			{
+				UE_LOG(AngryProceduralTools, Warning, TEXT("Triangle %d has invalid vertices %d, %d, %d."), Index, Triangle.Verts[0], Triangle.Verts[1], Triangle.Verts[2]);
+				return false;
+			}
+		}
+
+		const FVector2D& A = Points[Triangle.Verts[0]];
+		const FVector2D& B = Points[Triangle.Verts[1]];
+		const FVector2D& C = Points[Triangle.Verts[2]];
+		if (FGeometricPredicates::Orient2D(A, B, C) >= 0.0)
+		{
+			UE_LOG(AngryProceduralTools, Warning, TEXT("Triangle %d is flat or counter-clockwise."), Index);
+			return false;
+		}
+
+		for (int32 Edge = 0; Edge < 3; Edge++)
+		{
+			const int32 Adj = Triangle.Adjs[Edge];
+			if (Adj == INDEX_NONE) continue;
+
+			// Neighbour has to run along the same edge in the other direction and link back
+			const int32 From = Triangle.Verts[(Edge + 1) % 3];
+			const int32 To = Triangle.Verts[(Edge + 2) % 3];
+			const int32 YourEdge = Triangles.IsValidIndex(Adj) ? Triangles[Adj].OppositeOf(Triangle) : INDEX_NONE;
+			if (YourEdge == INDEX_NONE || Triangles[Adj].IsFreeSlot() || Triangles[Adj].Adjs[YourEdge] != Index ||
+				Triangles[Adj].Verts[(YourEdge + 1) % 3] != To || Triangles[Adj].Verts[(YourEdge + 2) % 3] != From)
+			{
+				UE_LOG(AngryProceduralTools, Warning, TEXT("Triangle %d isn't linked back by its neighbour %d across edge %d."), Index, Adj, Edge);
+				return false;
+			}
+
+			// Each interior edge is tested from one side, cocircular points are fine either way
+			if (Delaunay && Index < Adj && Triangle.Enabled && Triangles[Adj].Enabled && !IsConstrained(From, To))
+			{
+				const FVector2D& D = Points[Triangles[Adj].Verts[YourEdge]];
+				if (FGeometricPredicates::InCircle(A, B, C, D) < 0.0)
 				{
-					// Reapply old convex hull
-					NewConvex.Emplace(Edge);
+					UE_LOG(AngryProceduralTools, Warning, TEXT("Edge %d of triangle %d isn't Delaunay."), Edge, Index);
+					return false;
 				}
 			}
+		}
+	}
+	return true;
+}
+
+const FGenVoronoi& FTriangulation2D::GetVoronoi() const
+{
+	const int32 PointNum = Points.Num();
+	const int32 TriangleNum = Triangles.Num();
+	if (VoronoiValid && Voronoi.Centers.Num() == TriangleNum && Voronoi.Areas.Num() == PointNum)
+	{
+		return Voronoi;
+	}
+
+	// Centers and areas in one pass, each corner gets the quad between itself, its edge midpoints and the center
+	Voronoi.Centers.SetNumUninitialized(TriangleNum);
+	Voronoi.Areas.Init(0.0, PointNum);
+
+	// Degenerate triangles get their centroid
+	TArray<double> Radii;
+	Radii.SetNumUninitialized(TriangleNum);
+	UTriangleMath::ComputeCircumcenters2D(Points, Triangles, Voronoi.Centers, Radii);
+
+	TArray<int32> Hint;
+	Hint.Init(INDEX_NONE, PointNum);
+	for (int32 Index = 0; Index < TriangleNum; Index++)
+	{
+		const FGenTriangle& Triangle = Triangles[Index];
+		if (!Triangle.Enabled)
+		{
+			Voronoi.Centers[Index] = FVector2D::ZeroVector;
+			continue;
+		}
+		const FVector2D Center = Voronoi.Centers[Index];
+
+		for (int32 Slot = 0; Slot < 3; Slot++)
+		{
+			const int32 Vert = Triangle.Verts[Slot];
+			const FVector2D& Point = Points[Vert];
+			const FVector2D ToNext = (Points[Triangle.Verts[(Slot + 1) % 3]] - Point) * 0.5;
+			const FVector2D ToPrev = (Points[Triangle.Verts[(Slot + 2) % 3]] - Point) * 0.5;
+			const FVector2D ToCenter = Center - Point;
+
+			// Quad is clockwise like the triangle, obtuse triangles give negative parts that cancel out with their neighbours
+			Voronoi.Areas[Vert] -= ((ToNext ^ ToCenter) + (ToCenter ^ ToPrev)) * 0.5;
+			Hint[Vert] = Index;
+		}
+	}
+
+	// Order fans from the triangles found above, no point location needed
+	const auto IsCell = [&](int32 Index) -> bool
+	{
+		return Triangles.IsValidIndex(Index) && Triangles[Index].Enabled;
+	};
+
+	const auto SlotOf = [](const FGenTriangle& Triangle, int32 Vertex) -> int32
+	{
+		return Triangle.Verts[0] == Vertex ? 0 : (Triangle.Verts[1] == Vertex ? 1 : 2);
+	};
+
+	Voronoi.CellOffsets.SetNumUninitialized(PointNum + 1);
+	Voronoi.CellTriangles.Reset(TriangleNum * 3);
+	Voronoi.Open.Init(false, PointNum);
+	for (int32 Vertex = 0; Vertex < PointNum; Vertex++)
+	{
+		Voronoi.CellOffsets[Vertex] = Voronoi.CellTriangles.Num();
+
+		const int32 Start = Hint[Vertex];
+		if (Start == INDEX_NONE)
+		{
+			continue;
+		}
+
+		// Rotate counter-clockwise until the border so open cells start at one end
+		int32 First = Start;
+		for (int32 Step = 0; Step < TriangleNum; Step++)
+		{
+			const FGenTriangle& Triangle = Triangles[First];
+			const int32 Prev = Triangle.Adjs[(SlotOf(Triangle, Vertex) + 2) % 3];
+			if (!IsCell(Prev))
+			{
+				Voronoi.Open[Vertex] = true;
+				break;
+			}
+			if (Prev == Start)
+			{
+				break;
+			}
+			First = Prev;
+		}
 
-			Convex = NewConvex;
+		int32 Current = First;
+		for (int32 Step = 0; Step < TriangleNum; Step++)
+		{
+			Voronoi.CellTriangles.Emplace(Current);
+
+			const FGenTriangle& Triangle = Triangles[Current];
+			const int32 Next = Triangle.Adjs[(SlotOf(Triangle, Vertex) + 1) % 3];
+			if (!IsCell(Next) || Next == First)
+			{
+				break;
+			}
+			Current = Next;
 		}
 	}
+	Voronoi.CellOffsets[PointNum] = Voronoi.CellTriangles.Num();
+
+	// Only published once complete, readers racing a rebuild still have to be avoided by the caller
+	VoronoiValid = true;
+	return Voronoi;
+}
+
+const FGenVoronoi& FTriangulation2D::UpdateVoronoi()
+{
+	return GetVoronoi();
+}
+
+void FTriangulation2D::GetVoronoiCell(int32 Vertex, TArray<FVector2D>& Polygon) const
+{
+	Polygon.Reset();
+
+	const FGenVoronoi& Dual = GetVoronoi();
+	if (!Points.IsValidIndex(Vertex))
+	{
+		return;
+	}
+
+	const TArrayView<const int32> Cell = Dual.GetCell(Vertex);
+	if (Cell.Num() == 0)
+	{
+		return;
+	}
+
+	const auto SlotOf = [&](const FGenTriangle& Triangle) -> int32
+	{
+		return Triangle.Verts[0] == Vertex ? 0 : (Triangle.Verts[1] == Vertex ? 1 : 2);
+	};
+
+	// Open cells run from the midpoint of one border edge to the other and close over the vertex
+	const FVector2D& Point = Points[Vertex];
+	const bool Open = Dual.Open[Vertex];
+	if (Open)
+	{
+		const FGenTriangle& First = Triangles[Cell[0]];
+		Polygon.Emplace((Point + Points[First.Verts[(SlotOf(First) + 1) % 3]]) * 0.5);
+	}
+
+	for (int32 Triangle : Cell)
+	{
+		Polygon.Emplace(Dual.Centers[Triangle]);
+	}
+
+	if (Open)
+	{
+		const FGenTriangle& Last = Triangles[Cell.Last()];
+		Polygon.Emplace((Point + Points[Last.Verts[(SlotOf(Last) + 2) % 3]]) * 0.5);
+		Polygon.Emplace(Point);
+	}
 }
 
+bool FTriangulation2D::Serialize(FArchive& Ar)
+{
+	if (!HasBinaryLayout(Ar))
+	{
+		return false;
+	}
+
+	const bool Valid = SerializeTriangles(Ar);
+	Ar << Points;
+	Ar << Constraints;
+	Ar << FreeTriangles;
+
+	if (Ar.IsLoading())
+	{
+		// Nothing may walk indices that point outside of the buffers
+		bool Consistent = Valid && !Ar.IsError() && HasValidIndices(Points.Num());
+		for (int32 Index = 0; Index < FreeTriangles.Num() && Consistent; Index++)
+		{
+			Consistent = Triangles.IsValidIndex(FreeTriangles[Index]) && Triangles[FreeTriangles[Index]].IsFreeSlot();
+		}
+		for (const uint64 Key : Constraints)
+		{
+			if ((Key >> 32) >= (uint64)Points.Num() || (Key & 0xFFFFFFFF) >= (uint64)Points.Num())
+			{
+				Consistent = false;
+				break;
+			}
+		}
+
+		if (!Consistent)
+		{
+			Ar.SetError();
+			Reset();
+		}
+
+		ResetLocation();
+		InvalidateVoronoi();
+	}
+	return true;
+}
 
 FGenTriangleVertex::FGenTriangleVertex()
 	: Tangent(FVector::ZeroVector),
@@ -686,3 +3404,32 @@ FGenTriangleMesh::FGenTriangleMesh()
 	: Material(nullptr)
 {
 }
+
+bool FGenTriangleMesh::Serialize(FArchive& Ar)
+{
+	if (!HasBinaryLayout(Ar))
+	{
+		return false;
+	}
+
+	Triangulation.Serialize(Ar);
+	Ar << Vertices;
+	Ar << Convex;
+	Ar << Material;
+	return true;
+}
+
+FArchive& operator<<(FArchive& Ar, FGenTriangleVertex& Vertex)
+{
+	Ar << Vertex.Tangent;
+	Ar << Vertex.Normal;
+	Ar << Vertex.UV;
+	Ar << Vertex.Color;
+	return Ar;
+}
+
+FArchive& operator<<(FArchive& Ar, FGenConvexMesh& Mesh)
+{
+	Ar << Mesh.Points;
+	return Ar;
+}
@@ -0,0 +1,267 @@
+#include "Utility/Triangulation.h"
+#include "Utility/StaticTriangulation.h"
+#include "Utility/TriangleMath.h"
+#include "AngryProceduralTools.h"
+#include "HAL/IConsoleManager.h"
+
+/**
+ * Times the 2D Delaunay operations on synthetic clouds and logs the work counters, then the batched projections against their scalar versions.
+ * Correctness is covered by the AngryProceduralTools.Triangulation and AngryProceduralTools.TriangleMath specs.
+ * Needs no world or renderer, build agents can run it headless with
+ * -nullrhi -ExecCmds="Angry.Triangulation.Benchmark 100000, Quit".
+ */
+
+namespace
+{
+	enum class EBenchmarkCloud : uint8
+	{
+		Uniform,
+		Jittered,
+		Clustered,
+		Cocircular
+	};
+
+	const TCHAR* GetCloudName(EBenchmarkCloud Cloud)
+	{
+		switch (Cloud)
+		{
+		case EBenchmarkCloud::Uniform: return TEXT("Uniform");
+		case EBenchmarkCloud::Jittered: return TEXT("Jittered");
+		case EBenchmarkCloud::Clustered: return TEXT("Clustered");
+		default: return TEXT("Cocircular");
+		}
+	}
+
+	TArray<FVector2D> MakeCloud(EBenchmarkCloud Cloud, int32 Num, int32 Seed)
+	{
+		FRandomStream Random(Seed);
+		const int32 Samples = FMath::Max(FMath::CeilToInt(FMath::Sqrt((double)Num)) - 2, 1);
+
+		TArray<FVector2D> Points;
+		Points.Reserve(Num);
+		switch (Cloud)
+		{
+		case EBenchmarkCloud::Uniform:
+			while (Points.Num() < Num)
+			{
+				Points.Emplace(FVector2D(Random.FRand(), Random.FRand()));
+			}
+			break;
+
+		case EBenchmarkCloud::Jittered:
+			// Same samples as the world painter, clamping puts a lot of collinear points on the border
+			for (int32 SampleX = -1; SampleX <= Samples && Points.Num() < Num; SampleX++)
+			{
+				for (int32 SampleY = -1; SampleY <= Samples && Points.Num() < Num; SampleY++)
+				{
+					const float X = FMath::Clamp((((float)SampleX) + 0.5f + Random.FRandRange(-0.5f, 0.5f) * 0.5f) / Samples, 0.0f, 1.0f);
+					const float Y = FMath::Clamp((((float)SampleY) + 0.5f + Random.FRandRange(-0.5f, 0.5f) * 0.5f) / Samples, 0.0f, 1.0f);
+					Points.Emplace(FVector2D(X, Y));
+				}
+			}
+			break;
+
+		case EBenchmarkCloud::Clustered:
+		{
+			// Dense gaussian blobs with a few points in between, breaks uniform bucket assumptions
+			TArray<FVector2D> Centers;
+			for (int32 Index = 0; Index < 16; Index++)
+			{
+				Centers.Emplace(FVector2D(Random.FRand(), Random.FRand()));
+			}
+
+			while (Points.Num() < Num)
+			{
+				const FVector2D& Center = Centers[Random.RandHelper(Centers.Num())];
+				const double Radius = 0.01 * FMath::Sqrt(-2.0 * FMath::Loge(FMath::Max(Random.FRand(), SMALL_NUMBER)));
+				const double Angle = Random.FRand() * 2.0 * PI;
+				Points.Emplace(Center + FVector2D(FMath::Cos(Angle), FMath::Sin(Angle)) * Radius);
+			}
+			break;
+		}
+
+		default:
+			// Every cell of an exact grid is cocircular, the worst case for tie breaking
+			for (int32 Index = 0; Index < Num; Index++)
+			{
+				Points.Emplace(FVector2D(Index % (Samples + 2), Index / (Samples + 2)));
+			}
+			break;
+		}
+		return Points;
+	}
+
+	void Report(const TCHAR* Cloud, int32 Num, const TCHAR* Operation, double Seconds, const FTriangulation2D& Triangulation)
+	{
+		const FTriangulationCounters& Counters = Triangulation.Counters;
+		const double Rate = (Seconds > 0.0) ? Triangulation.Triangles.Num() / Seconds : 0.0;
+		UE_LOG(AngryProceduralTools, Display, TEXT("%-10s %8d %-14s %9.4fs %12.0f tris/s %10lld flips %10lld circle tests %10lld steps %6lld fallbacks %4lld cap hits"),
+			Cloud, Num, Operation, Seconds, Rate, Counters.Flips, Counters.CircleTests, Counters.LocateSteps, Counters.LocateFallbacks, Counters.CapHits);
+	}
+
+	// Many tiny shapes like caps and posts, where the general triangulation pays mostly for its setup
+	void RunSmallShapes(int32 Seed)
+	{
+		const int32 Shapes = 10000;
+		const int32 Num = 24;
+
+		FRandomStream Random(Seed);
+		TArray<FVector2D> Clouds;
+		Clouds.Reserve(Shapes * Num);
+		while (Clouds.Num() < Shapes * Num)
+		{
+			Clouds.Emplace(FVector2D(Random.FRand(), Random.FRand()));
+		}
+
+		double Start = FPlatformTime::Seconds();
+		for (int32 Shape = 0; Shape < Shapes; Shape++)
+		{
+			FTriangulation2D Triangulation;
+			Triangulation.QHull(TArray<FVector2D>(Clouds.GetData() + Shape * Num, Num), -1, true);
+		}
+		const double General = FPlatformTime::Seconds() - Start;
+
+		Start = FPlatformTime::Seconds();
+		for (int32 Shape = 0; Shape < Shapes; Shape++)
+		{
+			TStaticTriangulation<32> Triangulation;
+			Triangulation.Triangulate(TArrayView<const FVector2D>(Clouds.GetData() + Shape * Num, Num));
+		}
+		const double Static = FPlatformTime::Seconds() - Start;
+
+		UE_LOG(AngryProceduralTools, Display, TEXT("%-10s %8d %-14s %9.4fs QHull %9.4fs static"), TEXT("Small"), Shapes, TEXT("Shapes"), General, Static);
+	}
+
+	// Batched projections against their scalar reference
+	void RunProjections(int32 Seed)
+	{
+		const int32 Num = 1000000;
+		const int32 Slates = 16;
+
+		FRandomStream Random(Seed);
+		TArray<double> Coords[6];
+		for (TArray<double>& Coord : Coords)
+		{
+			Coord.Reserve(Num);
+			while (Coord.Num() < Num)
+			{
+				Coord.Emplace(Random.FRandRange(-1.0f, 1.0f));
+			}
+		}
+
+		TArray<float> Lengths;
+		TArray<float> ScalarLengths;
+		Lengths.SetNumUninitialized(Num);
+		ScalarLengths.SetNumUninitialized(Num);
+
+		double Start = FPlatformTime::Seconds();
+		UTriangleMath::ProjectToBox(Coords[0], Coords[1], Lengths);
+		const double Box = FPlatformTime::Seconds() - Start;
+
+		Start = FPlatformTime::Seconds();
+		UTriangleMath::ProjectToBoxScalar(Coords[0], Coords[1], ScalarLengths);
+		const double BoxScalar = FPlatformTime::Seconds() - Start;
+
+		const FPointsSoA Starts = { Coords[0], Coords[1], Coords[2] };
+		const FPointsSoA Ends = { Coords[3], Coords[4], Coords[5] };
+		TArray<bool> Hits;
+		TArray<bool> ScalarHits;
+		Hits.SetNumUninitialized(Num);
+		ScalarHits.SetNumUninitialized(Num);
+
+		double Slate = 0.0;
+		double SlateScalar = 0.0;
+		for (int32 Index = 0; Index < Slates; Index++)
+		{
+			const FVector A = Random.GetUnitVector();
+			const FVector B = Random.GetUnitVector();
+			const FVector Normal = (B - A) ^ Random.GetUnitVector();
+
+			Start = FPlatformTime::Seconds();
+			UTriangleMath::ProjectToSlate(Normal, A, B, Starts, Ends, Hits);
+			Slate += FPlatformTime::Seconds() - Start;
+
+			Start = FPlatformTime::Seconds();
+			UTriangleMath::ProjectToSlateScalar(Normal, A, B, Starts, Ends, ScalarHits);
+			SlateScalar += FPlatformTime::Seconds() - Start;
+		}
+
+		UE_LOG(AngryProceduralTools, Display, TEXT("%-10s %8d %-14s %9.4fs batch %9.4fs scalar"), TEXT("Project"), Num, TEXT("ToBox"), Box, BoxScalar);
+		UE_LOG(AngryProceduralTools, Display, TEXT("%-10s %8d %-14s %9.4fs batch %9.4fs scalar"), TEXT("Project"), Num * Slates, TEXT("ToSlate"), Slate, SlateScalar);
+	}
+
+	void RunBenchmark(const TArray<FString>& Args)
+	{
+		const int32 MaxPoints = (Args.Num() > 0) ? FCString::Atoi(*Args[0]) : 1000000;
+		const int32 Seed = (Args.Num() > 1) ? FCString::Atoi(*Args[1]) : 69;
+
+		for (int32 Num = 1000; Num <= MaxPoints; Num *= 10)
+		{
+			for (EBenchmarkCloud Type : { EBenchmarkCloud::Uniform, EBenchmarkCloud::Jittered, EBenchmarkCloud::Clustered, EBenchmarkCloud::Cocircular })
+			{
+				const TCHAR* Name = GetCloudName(Type);
+				const TArray<FVector2D> Cloud = MakeCloud(Type, Num, Seed);
+
+				FTriangulation2D Triangulation;
+				double Start = FPlatformTime::Seconds();
+				Triangulation.QHull(Cloud, -1, true);
+				Report(Name, Num, TEXT("QHull"), FPlatformTime::Seconds() - Start, Triangulation);
+
+				Triangulation.Counters.Reset();
+				Start = FPlatformTime::Seconds();
+				Triangulation.QHullParallel(Cloud);
+				Report(Name, Num, TEXT("QHullParallel"), FPlatformTime::Seconds() - Start, Triangulation);
+
+				// Unlegalized hull leaves all the flipping to FixTriangles
+				Triangulation.QHull(Cloud, -1, false);
+				Triangulation.Counters.Reset();
+				Start = FPlatformTime::Seconds();
+				Triangulation.FixTriangles(-1);
+				Report(Name, Num, TEXT("FixTriangles"), FPlatformTime::Seconds() - Start, Triangulation);
+
+				// Inserting every other point into a triangulation of the rest walks to every point first
+				TArray<FVector2D> Even;
+				TArray<FVector2D> Odd;
+				for (int32 Index = 0; Index < Num; Index++)
+				{
+					(Index % 2 == 0 ? Even : Odd).Emplace(Cloud[Index]);
+				}
+				Triangulation.QHull(MoveTemp(Even), -1, true);
+				Triangulation.Counters.Reset();
+				Start = FPlatformTime::Seconds();
+				Triangulation.AddPoints(Odd);
+				Report(Name, Num, TEXT("AddPoints"), FPlatformTime::Seconds() - Start, Triangulation);
+
+				// Scattered lookups at centroids of random triangles, the walk can't profit from coherence and points outside the hull don't measure the fallback
+				FRandomStream Random(Seed);
+				const int32 Queries = FMath::Min(Num, 100000);
+				TArray<FVector2D> Targets;
+				Targets.Reserve(Queries);
+				while (Targets.Num() < Queries)
+				{
+					const FGenTriangle& Triangle = Triangulation.Triangles[Random.RandHelper(Triangulation.Triangles.Num())];
+					Targets.Emplace((Triangulation.Points[Triangle.Verts[0]] + Triangulation.Points[Triangle.Verts[1]] + Triangulation.Points[Triangle.Verts[2]]) / 3.0);
+				}
+
+				int32 Misses = 0;
+				Triangulation.Counters.Reset();
+				Start = FPlatformTime::Seconds();
+				for (const FVector2D& Target : Targets)
+				{
+					Misses += Triangulation.FindTriangle(Target) == INDEX_NONE;
+				}
+				const double Seconds = FPlatformTime::Seconds() - Start;
+				UE_LOG(AngryProceduralTools, Display, TEXT("%-10s %8d %-14s %9.4fs %12.0f queries/s %10lld steps %6lld fallbacks %6d misses"),
+					Name, Num, TEXT("FindTriangle"), Seconds, (Seconds > 0.0) ? Queries / Seconds : 0.0, Triangulation.Counters.LocateSteps, Triangulation.Counters.LocateFallbacks, Misses);
+			}
+		}
+
+		RunSmallShapes(Seed);
+		RunProjections(Seed);
+	}
+}
+
+static FAutoConsoleCommand GTriangulationBenchmarkCommand(
+	TEXT("Angry.Triangulation.Benchmark"),
+	TEXT("Times 2D Delaunay triangulation on synthetic clouds from 1k points up to the given maximum (default 1M), small shapes and batched projections. Args: [MaxPoints] [Seed]"),
+	FConsoleCommandWithArgsDelegate::CreateStatic(&RunBenchmark));
@@ -0,0 +1,33 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Stats/Stats.h"
+#include "Utility/Triangulation.h"
+
+/**
+ * Stats of the triangulation core, shown with "stat AngryTriangulation".
+ * Counts accumulate over the session so they can be compared between bakes, cycle counters are per frame.
+ */
+DECLARE_STATS_GROUP(TEXT("AngryTriangulation"), STATGROUP_AngryTriangulation, STATCAT_Advanced);
+
+DECLARE_QWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Edge Flips"), STAT_AngryTriangulation_Flips, STATGROUP_AngryTriangulation, );
+DECLARE_QWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Circle Tests"), STAT_AngryTriangulation_CircleTests, STATGROUP_AngryTriangulation, );
+DECLARE_QWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Walk Steps"), STAT_AngryTriangulation_LocateSteps, STATGROUP_AngryTriangulation, );
+DECLARE_QWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Linear Searches"), STAT_AngryTriangulation_LocateFallbacks, STATGROUP_AngryTriangulation, );
+DECLARE_QWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Iteration Cap Hits"), STAT_AngryTriangulation_CapHits, STATGROUP_AngryTriangulation, );
+DECLARE_QWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Exact Predicates"), STAT_AngryTriangulation_ExactPredicates, STATGROUP_AngryTriangulation, );
+
+/** Cycle counter named after the function, stat scopes show up as CPU events in Insights as well */
+#define ANGRY_TRIANGULATION_SCOPE(Name) \
+	DECLARE_SCOPE_CYCLE_COUNTER(TEXT(#Name), STAT_AngryTriangulation_##Name, STATGROUP_AngryTriangulation)
+
+/** Adds work a loop counted locally to the triangulation and the stats at once, stat messages per iteration cost more than the work they count */
+FORCEINLINE void PublishTriangulationCounters(FTriangulationCounters& Counters, const FTriangulationCounters& Local)
+{
+	Counters += Local;
+	INC_DWORD_STAT_BY(STAT_AngryTriangulation_Flips, Local.Flips);
+	INC_DWORD_STAT_BY(STAT_AngryTriangulation_CircleTests, Local.CircleTests);
+	INC_DWORD_STAT_BY(STAT_AngryTriangulation_LocateSteps, Local.LocateSteps);
+	INC_DWORD_STAT_BY(STAT_AngryTriangulation_LocateFallbacks, Local.LocateFallbacks);
+	INC_DWORD_STAT_BY(STAT_AngryTriangulation_CapHits, Local.CapHits);
+}
@@ -71,6 +71,14 @@ public:
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Procedural Mesh|Collision")
 		bool EnableCollision;
 
+	/** Most vertices per convex collision hull, zero keeps all of them. Hulls stop growing at this or MaxConvexVolumeError, whichever comes first */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Procedural Mesh|Collision", meta = (ClampMin = 0))
+		int32 MaxConvexVertices;
+
+	/** Share of its volume a convex collision hull may lose to stay small, zero keeps all of it. A vertex budget reached first leaves a larger error, which is logged at Verbose */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Procedural Mesh|Collision", meta = (ClampMin = 0, ClampMax = 1))
+		float MaxConvexVolumeError;
+
 	////////////////////////////////////////////////////////////////////////////////////////////////////
 public:
 
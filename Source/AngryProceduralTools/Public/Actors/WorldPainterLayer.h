@@ -143,7 +143,21 @@ private:
 	bool GenerateTextureDone = false;
 	void GenerateTexture();
 
-	FTriangulation2D Triangulation;
+	// Triangulation only depends on the generator settings, saved with the layer so loading doesn't rebuild it
+	UPROPERTY()
+		FTriangulation2D Triangulation;
+
+	UPROPERTY()
+		int32 TriangulationSeed = INDEX_NONE;
+
+	/** Generator settings the saved triangulation was built with */
+	UPROPERTY()
+		uint32 TriangulationHash = 0;
+	uint32 GetTriangulationHash() const;
+
+	/** Whether the saved triangulation has used triangles with indices in range, text copies only bring back its points */
+	bool IsTriangulationIntact() const;
+
 	TArray<FBrushPoint> Points;
 	TArray<FBrushData> Vertices;
 };
\ No newline at end of file
@@ -31,6 +31,14 @@ struct ANGRYPROCEDURALTOOLS_API FDelaunaySurfaceParams
 
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Procedural Mesh")
 		bool Delaunay;
+
+	// Most triangles the surface may have, refines a triangulation of the border instead of filling a grid. Zero keeps the grid
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Procedural Mesh", meta = (ClampMin = 0))
+		int32 TriangleBudget;
+
+	// Smallest triangle angle in degrees refinement aims for within the budget, at most 30
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Procedural Mesh", meta = (ClampMin = 0, ClampMax = 30))
+		float MinAngle;
 };
 
 USTRUCT(BlueprintType)
@@ -235,9 +235,9 @@ public:
 		static void PopulateInstancedMesh(UInstancedStaticMeshComponent* Component, const TArray<FTransform>& Transforms);
 
 
-	/** Fill mesh sections of procedural mesh */
+	/** Fill mesh sections of procedural mesh. Convex collision is hulled and grows until it keeps all but MaxConvexVolumeError of its volume or reaches MaxConvexVertices, whichever comes first. Zero for both keeps full hulls */
 	UFUNCTION(BlueprintCallable, Category = "Procedural Mesh", Meta = (Keywords = "C++"))
-		static void ApplyToMeshes(UProceduralMeshComponent* ProceduralMesh, const TArray<FGenTriangleMesh>& Meshes, bool EnableCollision);
+		static void ApplyToMeshes(UProceduralMeshComponent* ProceduralMesh, const TArray<FGenTriangleMesh>& Meshes, bool EnableCollision, int32 MaxConvexVertices = 0, float MaxConvexVolumeError = 0.0f);
 
 	/** Destroy spline meshes */
 	UFUNCTION(BlueprintCallable, Category = "Procedural Mesh", Meta = (Keywords = "C++"))
@@ -0,0 +1,24 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * 3D convex hull by quickhull, always extending towards the point farthest outside of the hull so far.
+ * Every intermediate hull is a good approximation of the full one, so collision hulls can stop at a vertex budget or once they hold enough of the full volume.
+ * Faces are counter-clockwise seen from outside and index into Points.
+ */
+struct ANGRYPROCEDURALTOOLS_API FConvexHull
+{
+	/** Hull vertices in the order they were added */
+	TArray<FVector> Points;
+	TArray<FIntVector> Faces;
+
+	double Volume = 0.0;
+
+	/** Volume the hull misses relative to the hull of the whole cloud, zero unless reduced */
+	double VolumeError = 0.0;
+
+	/** Grows the hull until it misses at most MaxVolumeError of the full volume or one more vertex would exceed MaxVertices, whichever comes first.
+	 * Zero for both keeps the full hull. VolumeError tells what was reached. Fails without faces for fewer than four points or a flat cloud */
+	bool Build(TArrayView<const FVector> Cloud, int32 MaxVertices = 0, double MaxVolumeError = 0.0);
+};
@@ -0,0 +1,35 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Robust orientation and in-circle tests.
+ * Evaluated in plain double precision when the rounding error bound allows it, otherwise exactly with floating point expansions.
+ * Only the sign of the result is exact, the magnitude is an approximation of the determinant.
+ */
+struct ANGRYPROCEDURALTOOLS_API FGeometricPredicates
+{
+	/** Positive if A, B, C are counter-clockwise, negative if clockwise, zero if collinear */
+	static double Orient2D(const FVector2D& A, const FVector2D& B, const FVector2D& C);
+
+	/** Positive if D lies inside the circumcircle of counter-clockwise A, B, C, negative if outside, zero if cocircular. Sign flips for clockwise triangles */
+	static double InCircle(const FVector2D& A, const FVector2D& B, const FVector2D& C, const FVector2D& D);
+
+	/** InCircle with cocircular ties broken by lifting points in lexicographic order, so Delaunay triangulations of grids are unique. Only zero if three points are collinear */
+	static double InCirclePerturbed(const FVector2D& A, const FVector2D& B, const FVector2D& C, const FVector2D& D);
+
+	/** Positive if D lies below the plane through counter-clockwise A, B, C (seen from above), negative if above, zero if coplanar */
+	static double Orient3D(const FVector& A, const FVector& B, const FVector& C, const FVector& D);
+
+	/** Whether three points lie exactly on a line */
+	static bool IsCollinear(const FVector& A, const FVector& B, const FVector& C);
+
+	/** In-circle tests of point quads four at a time, only the double precision filter. Sign is positive if D lies inside the circumcircle of A, B, C in either winding.
+	 * Zero where rounding could decide, those need InCircle. Elsewhere agrees with InCircle(A, B, C, D) * Orient2D(A, B, C) */
+	static void ClassifyInCircles(TArrayView<const FVector2D> Points, TArrayView<const FIntVector4> Quads, TArrayView<int8> Signs);
+
+private:
+	static double Orient2DExact(const FVector2D& A, const FVector2D& B, const FVector2D& C);
+	static double InCircleExact(const FVector2D& A, const FVector2D& B, const FVector2D& C, const FVector2D& D);
+	static double Orient3DExact(const FVector& A, const FVector& B, const FVector& C, const FVector& D);
+};
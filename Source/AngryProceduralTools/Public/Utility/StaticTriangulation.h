@@ -0,0 +1,279 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Utility/Triangulation.h"
+#include "Utility/GeometricPredicates.h"
+#include "Algo/Sort.h"
+
+/**
+ * Delaunay triangulation of a handful of points with inline storage, for caps and short fills where QHull's setup costs more than the triangulation itself.
+ * Points are inserted in lexicographic order so each one lies outside the hull so far, no point location, hull hash or heap allocation is needed.
+ * Output follows FTriangulation2D: clockwise triangles, Adjs[E] across the edge opposite to Verts[E] and duplicates left unused in Points.
+ */
+template<int32 MaxPoints>
+struct TStaticTriangulation
+{
+	static_assert(MaxPoints >= 3 && MaxPoints <= 64, "Use FTriangulation2D for larger point sets");
+
+	/** A triangulation of N points with H on the hull has 2N - H - 2 triangles and at least three points are on the hull */
+	static constexpr int32 MaxTriangles = 2 * MaxPoints - 5;
+
+	TArray<FVector2D, TFixedAllocator<MaxPoints>> Points;
+	TArray<FGenTriangle, TFixedAllocator<MaxTriangles>> Triangles;
+
+	/** Fails without triangles if there are more than MaxPoints points or all of them are collinear */
+	bool Triangulate(TArrayView<const FVector2D> Cloud);
+
+	/** Hands the result to a general triangulation, e.g. to add constraints */
+	void CopyTo(FTriangulation2D& Triangulation) const;
+
+private:
+	/** Each triangle edge is queued at most once, so the stack never holds more than all of them */
+	typedef TArray<FGenTriangleEdge, TFixedAllocator<MaxTriangles * 3>> FFlipStack;
+
+	void FlipEdge(int32 Index, int32 Edge);
+	void PushEdge(FFlipStack& FlipStack, int32 Index, int32 Edge);
+	void LegalizeEdges(FFlipStack& FlipStack, bool AllEdges);
+	void ExtendHull(int32 PointIndex, int32 Previous, FFlipStack& FlipStack);
+
+	// One bit per triangle edge on the flip stack
+	uint64 Queued[(MaxTriangles * 3 + 63) / 64];
+
+	// Convex hull as a linked list along the triangle winding, HullTri stores the triangle owning the edge starting at each vertex
+	int32 HullNext[MaxPoints];
+	int32 HullPrev[MaxPoints];
+	int32 HullTri[MaxPoints];
+};
+
+template<int32 MaxPoints>
+bool TStaticTriangulation<MaxPoints>::Triangulate(TArrayView<const FVector2D> Cloud)
+{
+	Points.Reset();
+	Triangles.Reset();
+	FMemory::Memzero(Queued);
+
+	const int32 Num = Cloud.Num();
+	if (Num > MaxPoints)
+	{
+		return false;
+	}
+	Points.Append(Cloud.GetData(), Num);
+
+	// Lexicographic order with ties by index, so of several equal points the first is the one kept
+	TArray<int32, TFixedAllocator<MaxPoints>> Order;
+	for (int32 Index = 0; Index < Num; Index++)
+	{
+		Order.Emplace(Index);
+	}
+	Algo::Sort(Order, [this](int32 A, int32 B) { return Points[A].X < Points[B].X || (Points[A].X == Points[B].X && (Points[A].Y < Points[B].Y || (Points[A].Y == Points[B].Y && A < B))); });
+
+	int32 Unique = 0;
+	for (int32 Index = 0; Index < Order.Num(); Index++)
+	{
+		if (Unique == 0 || Points[Order[Index]] != Points[Order[Unique - 1]])
+		{
+			Order[Unique++] = Order[Index];
+		}
+	}
+
+	// Leading collinear points are fanned to the first point off their line
+	int32 Apex = 2;
+	while (Apex < Unique && FGeometricPredicates::Orient2D(Points[Order[0]], Points[Order[1]], Points[Order[Apex]]) == 0.0)
+	{
+		Apex++;
+	}
+
+	if (Apex >= Unique)
+	{
+		return false;
+	}
+
+	FFlipStack FlipStack;
+	const bool Clockwise = FGeometricPredicates::Orient2D(Points[Order[0]], Points[Order[1]], Points[Order[Apex]]) < 0.0;
+	for (int32 Index = 0; Index < Apex - 1; Index++)
+	{
+		const int32 Prev = (Index > 0) ? Index - 1 : INDEX_NONE;
+		const int32 Next = (Index < Apex - 2) ? Index + 1 : INDEX_NONE;
+
+		FGenTriangle Triangle = Clockwise ? FGenTriangle(Order[Index], Order[Index + 1], Order[Apex]) : FGenTriangle(Order[Index + 1], Order[Index], Order[Apex]);
+		Triangle.Adjs[0] = Clockwise ? Next : Prev;
+		Triangle.Adjs[1] = Clockwise ? Prev : Next;
+		Triangles.Emplace(Triangle);
+
+		if (Next != INDEX_NONE)
+		{
+			PushEdge(FlipStack, Index, Clockwise ? 0 : 1);
+		}
+	}
+	for (int32 Index = 0; Index < Triangles.Num(); Index++)
+	{
+		for (int32 Edge = 0; Edge < 3; Edge++)
+		{
+			if (Triangles[Index].Adjs[Edge] == INDEX_NONE)
+			{
+				const int32 From = Triangles[Index].Verts[(Edge + 1) % 3];
+				const int32 To = Triangles[Index].Verts[(Edge + 2) % 3];
+				HullNext[From] = To;
+				HullPrev[To] = From;
+				HullTri[From] = Index;
+			}
+		}
+	}
+	LegalizeEdges(FlipStack, true);
+
+	for (int32 Index = Apex + 1; Index < Unique; Index++)
+	{
+		ExtendHull(Order[Index], Order[Index - 1], FlipStack);
+	}
+	return true;
+}
+
+template<int32 MaxPoints>
+void TStaticTriangulation<MaxPoints>::CopyTo(FTriangulation2D& Triangulation) const
+{
+	Triangulation.Reset();
+	Triangulation.Points.Append(Points);
+	Triangulation.Triangles.Append(Triangles);
+}
+
+template<int32 MaxPoints>
+void TStaticTriangulation<MaxPoints>::FlipEdge(int32 Index, int32 Edge)
+{
+	// Same rotation as FTriangulation::FlipEdge, the vertex opposite to the edge keeps its slot in Mine
+	const int32 Adj = Triangles[Index].Adjs[Edge];
+	FGenTriangle& Mine = Triangles[Index];
+	FGenTriangle& Your = Triangles[Adj];
+	const int32 YourEdge = Your.OppositeOf(Mine);
+
+	const int32 MineNext = (Edge + 1) % 3;
+	const int32 MinePrev = (Edge + 2) % 3;
+	const int32 YourNext = (YourEdge + 1) % 3;
+	const int32 YourPrev = (YourEdge + 2) % 3;
+	Mine.Verts[MineNext] = Your.Verts[YourEdge];
+	Your.Verts[YourNext] = Mine.Verts[Edge];
+
+	Your.Adjs[YourEdge] = Mine.Adjs[MinePrev];
+	Mine.Adjs[MinePrev] = Adj;
+	Mine.Adjs[Edge] = Your.Adjs[YourPrev];
+	Your.Adjs[YourPrev] = Index;
+
+	if (Mine.Adjs[Edge] != INDEX_NONE)
+	{
+		Triangles[Mine.Adjs[Edge]].ReplaceAdj(Adj, Index);
+	}
+
+	if (Your.Adjs[YourEdge] != INDEX_NONE)
+	{
+		Triangles[Your.Adjs[YourEdge]].ReplaceAdj(Index, Adj);
+	}
+}
+
+template<int32 MaxPoints>
+void TStaticTriangulation<MaxPoints>::PushEdge(FFlipStack& FlipStack, int32 Index, int32 Edge)
+{
+	// An edge already queued is checked in whatever state it has when popped, queueing it again adds nothing
+	const int32 Bit = Index * 3 + Edge;
+	if (!(Queued[Bit / 64] & (1ull << (Bit % 64))))
+	{
+		Queued[Bit / 64] |= 1ull << (Bit % 64);
+		FlipStack.Emplace(FGenTriangleEdge(Index, Edge));
+	}
+}
+
+template<int32 MaxPoints>
+void TStaticTriangulation<MaxPoints>::LegalizeEdges(FFlipStack& FlipStack, bool AllEdges)
+{
+	while (FlipStack.Num() > 0)
+	{
+		const FGenTriangleEdge Edge = FlipStack.Pop(false);
+		Queued[(Edge.T * 3 + Edge.E) / 64] &= ~(1ull << ((Edge.T * 3 + Edge.E) % 64));
+		const FGenTriangle& Mine = Triangles[Edge.T];
+		const int32 Adj = Mine.Adjs[Edge.E];
+		if (Adj == INDEX_NONE) continue;
+
+		const FGenTriangle& Your = Triangles[Adj];
+		const int32 YourEdge = Your.OppositeOf(Mine);
+		if (YourEdge == INDEX_NONE) continue;
+		if (FGeometricPredicates::InCirclePerturbed(Points[Mine.Verts[0]], Points[Mine.Verts[1]], Points[Mine.Verts[2]], Points[Your.Verts[YourEdge]]) >= 0.0) continue;
+
+		FlipEdge(Edge.T, Edge.E);
+
+		// Hull edges can move to the other triangle
+		const FGenTriangle& NewMine = Triangles[Edge.T];
+		if (NewMine.Adjs[Edge.E] == INDEX_NONE)
+		{
+			HullTri[NewMine.Verts[(Edge.E + 1) % 3]] = Edge.T;
+		}
+
+		const FGenTriangle& NewYour = Triangles[Adj];
+		if (NewYour.Adjs[YourEdge] == INDEX_NONE)
+		{
+			HullTri[NewYour.Verts[(YourEdge + 1) % 3]] = Adj;
+		}
+
+		PushEdge(FlipStack, Edge.T, Edge.E);
+		PushEdge(FlipStack, Adj, (YourEdge + 1) % 3);
+		if (AllEdges)
+		{
+			PushEdge(FlipStack, Edge.T, (Edge.E + 1) % 3);
+			PushEdge(FlipStack, Adj, YourEdge);
+		}
+	}
+}
+
+template<int32 MaxPoints>
+void TStaticTriangulation<MaxPoints>::ExtendHull(int32 PointIndex, int32 Previous, FFlipStack& FlipStack)
+{
+	const FVector2D& Point = Points[PointIndex];
+	const auto IsVisible = [&](int32 From, int32 To) -> bool
+	{
+		return FGeometricPredicates::Orient2D(Points[From], Points[To], Point) > 0.0;
+	};
+
+	// The previously inserted point is the rightmost so far, the edges visible to the next point are a chain through it
+	int32 First = Previous;
+	while (IsVisible(HullPrev[First], First))
+	{
+		First = HullPrev[First];
+	}
+
+	int32 Last = Previous;
+	while (IsVisible(Last, HullNext[Last]))
+	{
+		Last = HullNext[Last];
+	}
+
+	// Connect to every edge of the chain, neighbouring new triangles share the spoke to the vertex between them
+	int32 PrevTri = INDEX_NONE;
+	for (int32 From = First; From != Last; From = HullNext[From])
+	{
+		const int32 To = HullNext[From];
+		const int32 Index = HullTri[From];
+		const FGenTriangle& Triangle = Triangles[Index];
+		const int32 Vert = (Triangle.Verts[0] == From) ? 0 : ((Triangle.Verts[1] == From) ? 1 : 2);
+
+		FGenTriangle Outer(To, From, PointIndex);
+		Outer.Adjs[2] = Index;
+		Outer.Adjs[0] = PrevTri;
+		const int32 New = Triangles.Emplace(Outer);
+		Triangles[Index].Adjs[(Vert + 2) % 3] = New;
+		if (PrevTri != INDEX_NONE)
+		{
+			Triangles[PrevTri].Adjs[1] = New;
+		}
+		else
+		{
+			HullTri[First] = New;
+		}
+		PushEdge(FlipStack, New, 2);
+		PrevTri = New;
+	}
+
+	HullNext[First] = PointIndex;
+	HullPrev[PointIndex] = First;
+	HullNext[PointIndex] = Last;
+	HullPrev[Last] = PointIndex;
+	HullTri[PointIndex] = PrevTri;
+
+	LegalizeEdges(FlipStack, false);
+}
@@ -0,0 +1,142 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+struct FTriangulation3D;
+
+/**
+ * Bounding volume hierarchy over the triangles of a mesh or the segments of a polyline.
+ * Nodes are stored depth first, the left child of an inner node directly follows it.
+ * Primitives keep the index they had in the source so results can be mapped back without a lookup.
+ */
+struct ANGRYPROCEDURALTOOLS_API FTriangleBVH
+{
+	struct FNode
+	{
+		FBox Bounds;
+
+		/** First primitive for leaves, right child for inner nodes */
+		int32 Offset;
+
+		/** Number of primitives, zero for inner nodes */
+		int32 Num;
+	};
+
+	TArray<FNode> Nodes;
+	TArray<FVector> Points;
+
+	/** Vertex indices per primitive in leaf order, segments repeat their last vertex */
+	TArray<FIntVector> Primitives;
+
+	/** Triangle or segment index each primitive came from */
+	TArray<int32> Sources;
+
+	/** Builds over all enabled triangles */
+	void Build(const FTriangulation3D& Triangulation);
+
+	/** Builds over the segments between consecutive points, segment I runs from point I to the next */
+	void Build(TArrayView<const FVector> Polyline, bool Closed);
+
+	FORCEINLINE bool IsSegment(int32 Primitive) const { return Primitives[Primitive].Y == Primitives[Primitive].Z; }
+
+	/** Closest triangle hit along a segment, returns the source triangle or INDEX_NONE. Time is relative to the segment */
+	int32 IntersectSegment(const FVector& From, const FVector& To, double& Time) const;
+
+	/** Closest primitive to a point, returns the source index or INDEX_NONE if empty. Visits the nearer child first */
+	int32 FindNearest(const FVector& Point, FVector& Closest) const;
+
+	/** Whether a point is inside a closed triangle mesh, counts crossings along a ray. Rays passing through an edge or vertex are replaced by another direction,
+	 * if all of them are ambiguous the last one is used anyway */
+	bool IsInside(const FVector& Point) const;
+
+	/** Calls Visit with the source index of every primitive whose bounds overlap the box until it returns true, returns whether it did */
+	template<typename FunctorType>
+	bool AnyInBox(const FBox& Box, FunctorType&& Visit) const
+	{
+		return Traverse([&Box](const FBox& Bounds) { return Bounds.Intersect(Box); }, [this, &Visit](int32 Primitive) { return Visit(Sources[Primitive]); });
+	}
+
+	/** Like AnyInBox for the triangle extruded infinitely along its normal, grown by Margin */
+	template<typename FunctorType>
+	bool AnyInPrism(const FVector& A, const FVector& B, const FVector& C, double Margin, FunctorType&& Visit) const
+	{
+		const FVector Normal = (B - A) ^ (C - A);
+		if (Normal.SizeSquared() < SMALL_NUMBER)
+		{
+			return false;
+		}
+
+		// Edge normals within the triangle plane are separating axes, the prism is unbounded along the normal only
+		FVector Axes[3];
+		FVector2D Ranges[3];
+		const FVector Corners[3] = { A, B, C };
+		for (int32 Edge = 0; Edge < 3; Edge++)
+		{
+			Axes[Edge] = ((Corners[(Edge + 1) % 3] - Corners[Edge]) ^ Normal).GetSafeNormal();
+			const double DotA = A | Axes[Edge];
+			const double DotB = B | Axes[Edge];
+			const double DotC = C | Axes[Edge];
+			Ranges[Edge] = FVector2D(FMath::Min3(DotA, DotB, DotC) - Margin, FMath::Max3(DotA, DotB, DotC) + Margin);
+		}
+
+		return Traverse([&Axes, &Ranges](const FBox& Bounds)
+		{
+			const FVector Center = Bounds.GetCenter();
+			const FVector Extent = Bounds.GetExtent();
+			for (int32 Edge = 0; Edge < 3; Edge++)
+			{
+				const double Mid = Center | Axes[Edge];
+				const double Radius = Extent | Axes[Edge].GetAbs();
+				if (Mid + Radius < Ranges[Edge].X || Mid - Radius > Ranges[Edge].Y)
+				{
+					return false;
+				}
+			}
+			return true;
+		}, [this, &Visit](int32 Primitive) { return Visit(Sources[Primitive]); });
+	}
+
+private:
+	void BuildNodes();
+
+	FBox GetBounds(int32 Primitive) const;
+
+	/** Descends into every node passing the test and stops as soon as Visit returns true for a primitive in leaf order */
+	template<typename TestType, typename FunctorType>
+	bool Traverse(TestType&& Test, FunctorType&& Visit) const
+	{
+		if (Nodes.Num() == 0)
+		{
+			return false;
+		}
+
+		TArray<int32, TInlineAllocator<64>> Stack;
+		Stack.Emplace(0);
+		while (Stack.Num() > 0)
+		{
+			const int32 Index = Stack.Pop(false);
+			const FNode& Node = Nodes[Index];
+			if (!Test(Node.Bounds))
+			{
+				continue;
+			}
+
+			if (Node.Num > 0)
+			{
+				for (int32 Primitive = Node.Offset; Primitive < Node.Offset + Node.Num; Primitive++)
+				{
+					if (Visit(Primitive))
+					{
+						return true;
+					}
+				}
+			}
+			else
+			{
+				Stack.Emplace(Node.Offset);
+				Stack.Emplace(Index + 1);
+			}
+		}
+		return false;
+	}
+};
@@ -4,6 +4,18 @@
 
 #include "TriangleMath.generated.h"
 
+struct FGenTriangle;
+
+/** Points stored as one array per coordinate, batch kernels load four values of a coordinate at once */
+struct FPointsSoA
+{
+	TArrayView<const double> X;
+	TArrayView<const double> Y;
+	TArrayView<const double> Z;
+
+	FORCEINLINE int32 Num() const { return X.Num(); }
+};
+
 /**
  *
  */
@@ -21,6 +33,17 @@ public:
 	UFUNCTION(BlueprintPure, Category = "Math", meta = (Keywords = "C++"))
 		static bool ProjectToSlate(const FVector& Normal, const FVector& A, const FVector& B, const FVector& S, const FVector& T);
 
+	/** ProjectToBox of vectors given per coordinate, four at a time */
+	static void ProjectToBox(TArrayView<const double> X, TArrayView<const double> Y, TArrayView<float> Out);
+
+	/** ProjectToSlate of segments from Starts to Ends against one slate, four at a time. Lanes compute in double where ProjectToSlate rounds to float,
+	 * segments within float precision of the slate border may be decided differently. Counts not divisible by four end in the scalar version */
+	static void ProjectToSlate(const FVector& Normal, const FVector& A, const FVector& B, const FPointsSoA& Starts, const FPointsSoA& Ends, TArrayView<bool> Out);
+
+	/** One vector or segment at a time, reference for the batched versions */
+	static void ProjectToBoxScalar(TArrayView<const double> X, TArrayView<const double> Y, TArrayView<float> Out);
+	static void ProjectToSlateScalar(const FVector& Normal, const FVector& A, const FVector& B, const FPointsSoA& Starts, const FPointsSoA& Ends, TArrayView<bool> Out);
+
 	/** Computes the circumcenter of a given triangle */
 	UFUNCTION(BlueprintPure, Category = "Math", meta = (Keywords = "C++"))
 		static bool ComputeCircumcenter(const FVector& A, const FVector& B, const FVector& C, FVector& Out);
@@ -28,4 +51,13 @@ public:
 	/** Computes the circumcenter of a given triangle */
 	UFUNCTION(BlueprintPure, Category = "Math", meta = (Keywords = "C++"))
 		static bool ComputeCircumcenter2D(const FVector2D& A, const FVector2D& B, const FVector2D& C, FVector2D& Out);
+
+	/** Circumcenters and squared radii of triangles four at a time, radii are measured to the first vertex.
+	 * Degenerate or badly conditioned lanes go through ComputeCircumcenter, free slots without vertices get zero */
+	static void ComputeCircumcenters(TArrayView<const FVector> Points, TArrayView<const FGenTriangle> Triangles, TArrayView<FVector> Centers, TArrayView<double> Radii);
+	static void ComputeCircumcenters2D(TArrayView<const FVector2D> Points, TArrayView<const FGenTriangle> Triangles, TArrayView<FVector2D> Centers, TArrayView<double> Radii);
+
+	/** One triangle at a time, reference for the batched versions */
+	static void ComputeCircumcentersScalar(TArrayView<const FVector> Points, TArrayView<const FGenTriangle> Triangles, TArrayView<FVector> Centers, TArrayView<double> Radii);
+	static void ComputeCircumcenters2DScalar(TArrayView<const FVector2D> Points, TArrayView<const FGenTriangle> Triangles, TArrayView<FVector2D> Centers, TArrayView<double> Radii);
 };
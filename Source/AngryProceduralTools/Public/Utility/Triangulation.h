@@ -2,6 +2,7 @@
 #pragma once
 
 #include "CoreMinimal.h"
+#include "Misc/MemStack.h"
 #include "Triangulation.generated.h"
 
 USTRUCT(BlueprintType)
@@ -39,6 +40,9 @@ public:
 
 	void ClearAdjs();
 	bool HasVertex(int32 Vertex) const;
+
+	/** Slots released by FTriangulation2D::RemovePoint stay in the buffer until Compact, they have Verts[0] == INDEX_NONE and Enabled false */
+	bool IsFreeSlot() const;
 	void ReplaceAdj(int32 From, int32 To);
 	int32 OppositeOf(const FGenTriangle& Other) const;
 	bool IsConnected(const FGenTriangle& Other) const;
@@ -48,6 +52,89 @@ public:
 	bool Enabled;
 };
 
+/** Why FTriangulation2D::AddHole rejected a loop */
+enum class ETriangulationHoleError : uint8
+{
+	None,
+	/** Fewer than three vertices or a loop without area */
+	Degenerate,
+	/** Loop edges cross each other or a vertex is visited twice */
+	SelfIntersecting,
+	/** A loop edge crosses a constraint that existed before, usually the outline of another hole */
+	CrossesConstraint,
+	/** A loop vertex is not part of the triangulation or a loop edge leaves the triangulated domain */
+	OutsideDomain
+};
+
+/** Work done by the Delaunay operations of a triangulation since it was last reset */
+struct FTriangulationCounters
+{
+	int64 Flips = 0;
+	int64 CircleTests = 0;
+
+	/** Triangles visited while walking towards a point and walks that gave up and tested every triangle */
+	int64 LocateSteps = 0;
+	int64 LocateFallbacks = 0;
+
+	/** Loops that stopped at their iteration limit before they were done */
+	int64 CapHits = 0;
+
+	FORCEINLINE void Reset() { *this = FTriangulationCounters(); }
+
+	FORCEINLINE FTriangulationCounters& operator+=(const FTriangulationCounters& Other)
+	{
+		Flips += Other.Flips;
+		CircleTests += Other.CircleTests;
+		LocateSteps += Other.LocateSteps;
+		LocateFallbacks += Other.LocateFallbacks;
+		CapHits += Other.CapHits;
+		return *this;
+	}
+};
+
+/**
+ * Temporaries of the Delaunay operations, pass the same scratch to consecutive calls so regenerating many triangulations doesn't allocate each time.
+ * Arrays are reset but keep their memory between calls.
+ */
+template<typename AllocatorType>
+struct TTriangulationScratch
+{
+	// QHull and AddPoints
+	TArray<int32, AllocatorType> Order;
+	TArray<double, AllocatorType> Dists;
+	TArray<uint64, AllocatorType> Keys;
+	TArray<int32, AllocatorType> HullNext;
+	TArray<int32, AllocatorType> HullPrev;
+	TArray<int32, AllocatorType> HullTri;
+	TArray<int32, AllocatorType> HullHash;
+	TArray<FGenTriangleEdge, AllocatorType> FlipStack;
+
+	// FixTriangles
+	TArray<FVector, AllocatorType> Centers;
+	TArray<double, AllocatorType> Radius;
+	TArray<FGenTriangleEdge, AllocatorType> Dirty;
+	TBitArray<TInlineAllocator<4, AllocatorType>> Queued;
+	TArray<FIntVector4, AllocatorType> Quads;
+	TArray<int8, AllocatorType> Signs;
+
+	/** Most bytes held at the end of any call so far, what a caller has to budget for */
+	SIZE_T PeakBytes = 0;
+
+	SIZE_T GetAllocatedSize() const
+	{
+		return Order.GetAllocatedSize() + Dists.GetAllocatedSize() + Keys.GetAllocatedSize() + HullNext.GetAllocatedSize() + HullPrev.GetAllocatedSize()
+			+ HullTri.GetAllocatedSize() + HullHash.GetAllocatedSize() + FlipStack.GetAllocatedSize() + Centers.GetAllocatedSize() + Radius.GetAllocatedSize()
+			+ Dirty.GetAllocatedSize() + Queued.GetAllocatedSize() + Quads.GetAllocatedSize() + Signs.GetAllocatedSize();
+	}
+
+	FORCEINLINE void UpdatePeak() { PeakBytes = FMath::Max(PeakBytes, GetAllocatedSize()); }
+};
+
+using FTriangulationScratch = TTriangulationScratch<FDefaultAllocator>;
+
+/** Allocates from the thread's FMemStack, only valid within the FMemMark it was created under */
+using FTriangulationMemStackScratch = TTriangulationScratch<TMemStackAllocator<>>;
+
 USTRUCT(BlueprintType)
 struct ANGRYPROCEDURALTOOLS_API FTriangulation
 {
@@ -59,6 +146,28 @@ public:
 
 	void Reparent(const TArray<int32>& TriangleIndices);
 	void ReparentAll();
+
+	/** Links all triangles sharing an edge in linear time. Edges used by more than two triangles or with flipped winding stay unlinked on every triangle,
+	 * so do edges of degenerate triangles that would link to themselves. Returns the number of such non-manifold directed edges */
+	int32 BuildAdjacency();
+
+	/** Flips the edge opposite to given vertex with the neighbouring triangle, returns the neighbour's edge index or INDEX_NONE if there is no neighbour.
+	 * Doesn't count towards Counters, the Delaunay loops calling it count their flips */
+	int32 FlipEdge(int32 Index, int32 Edge);
+
+	/** Whether given vertex of a triangle shares an edge with another vertex, walks the triangle fan around the vertex */
+	bool IsVertexConnected(int32 Index, int32 Vert, int32 Other) const;
+
+	/** Not serialized. Const lookups like FindTriangle count too and write it unsynchronized, the same as their location cache,
+	 * so lookups on one triangulation from several threads race on it. Give each thread its own copy or lock around them */
+	mutable FTriangulationCounters Counters;
+
+	/** Whether all vertex and neighbour indices of used slots are in range */
+	bool HasValidIndices(int32 PointNum) const;
+
+protected:
+	/** Vertex indices as packed deltas to the previous vertex, neighbours as packed offsets to their triangle. Returns false and sets an error on impossible counts */
+	bool SerializeTriangles(FArchive& Ar);
 };
 
 USTRUCT(BlueprintType)
@@ -72,10 +181,48 @@ public:
 
 
 	void DrawTriangles(UWorld* World, const FTransform& Transform);
-	void Circumcenter(int32 Index, FVector& Center, float& Radius) const;
+	void Circumcenter(int32 Index, FVector& Center, double& Radius) const;
 	bool FixTriangles(int32 MaxIterations);
+
+	/** Circumcircle cache and edge queue come from the scratch */
+	template<typename AllocatorType>
+	bool FixTriangles(int32 MaxIterations, TTriangulationScratch<AllocatorType>& Scratch);
+
+	/** Versioned binary layout, packages saved before it exists fall back to tagged properties. Out of range indices set an archive error and leave the triangulation empty */
+	bool Serialize(FArchive& Ar);
 };
 
+template<>
+struct TStructOpsTypeTraits<FTriangulation3D> : public TStructOpsTypeTraitsBase2<FTriangulation3D>
+{
+	enum { WithSerializer = true };
+};
+
+/**
+ * Voronoi dual of a 2D triangulation, computed in one pass and cached on the triangulation.
+ * Cells of border vertices are closed through the midpoints of their border edges and the vertex itself.
+ */
+USTRUCT(BlueprintType)
+struct ANGRYPROCEDURALTOOLS_API FGenVoronoi
+{
+	GENERATED_USTRUCT_BODY()
+public:
+
+	/** Circumcenter per triangle slot, centroid for degenerate triangles */
+	TArray<FVector2D> Centers;
+
+	/** Triangles around vertex V in clockwise order are CellTriangles[CellOffsets[V]] up to CellTriangles[CellOffsets[V + 1]] */
+	TArray<int32> CellOffsets;
+	TArray<int32> CellTriangles;
+
+	/** Circumcentric cell area per vertex, all cells add up to the triangulated area even where circumcenters lie outside their triangle */
+	TArray<double> Areas;
+
+	/** One bit per vertex whose cell reaches the border */
+	TBitArray<> Open;
+
+	FORCEINLINE TArrayView<const int32> GetCell(int32 Vertex) const { return TArrayView<const int32>(CellTriangles.GetData() + CellOffsets[Vertex], CellOffsets[Vertex + 1] - CellOffsets[Vertex]); }
+};
 
 USTRUCT(BlueprintType)
 struct ANGRYPROCEDURALTOOLS_API FTriangulation2D : public FTriangulation
@@ -86,18 +233,152 @@ public:
 	UPROPERTY(EditAnywhere, Category = "Procedural Mesh")
 		TArray<FVector2D> Points;
 
-	void Circumcenter(int32 Index, FVector2D& Center, float& Radius) const;
+	void Circumcenter(int32 Index, FVector2D& Center, double& Radius) const;
 	bool FixTriangles(int32 MaxIterations);
 
+	/** Reuses the buffers of a scratch, instantiated for FTriangulationScratch and FTriangulationMemStackScratch like all scratch overloads */
+	template<typename AllocatorType>
+	bool FixTriangles(int32 MaxIterations, TTriangulationScratch<AllocatorType>& Scratch);
+
 	FVector ComputeArea(const FGenTriangle& Triangle) const;
 	FVector InsideCheck(const FGenTriangle& Triangle, const FVector2D& Point) const;
+
+	/** Walks from the last found triangle or a bucket close to the point, falls back to testing all triangles.
+	 * Updates the location cache and Counters, not safe to call concurrently on the same triangulation */
 	int32 FindTriangle(const FVector2D& Point) const;
+	int32 FindTriangleLinear(const FVector2D& Point) const;
+	void ResetLocation();
 
 	int32 CutEdge(int32 TriangleIndex, int32 NeighbourIndex, int32 Edge, int32 PointIndex);
 	void SetBorders(const FVector2D& Min, const FVector2D& Max);
-	void AddPoints(const FVector2D& Point);
 
-	void QHull(TArray<FVector2D> Cloud, int32 Iterations);
+	/** Inserts a point and flips the surrounding edges so the triangulation stays Delaunay, returns the vertex at that location or INDEX_NONE if outside */
+	int32 AddPoints(const FVector2D& Point);
+
+	template<typename AllocatorType>
+	int32 AddPoints(const FVector2D& Point, TTriangulationScratch<AllocatorType>& Scratch);
+
+	/** Inserts points in a biased randomized order sorted along a Hilbert curve, runs QHull if there are no triangles yet */
+	void AddPoints(TArrayView<const FVector2D> Batch);
+
+	template<typename AllocatorType>
+	void AddPoints(TArrayView<const FVector2D> Batch, TTriangulationScratch<AllocatorType>& Scratch);
+
+	/** Flips edges on the stack until they are Delaunay, each entry is the edge opposite to a newly inserted point. AllEdges checks the whole quad after each flip for stacks that don't come from insertion.
+	 * Stops after MaxChecks edge tests unless negative */
+	template<typename AllocatorType>
+	void LegalizeEdges(TArray<FGenTriangleEdge, AllocatorType>& FlipStack, TArray<int32, TIdentity_T<AllocatorType>>* HullTri = nullptr, bool AllEdges = false, int32 MaxChecks = -1);
+
+	/** Triangulates a point cloud, legalize flips edges on insertion so the result is Delaunay without calling FixTriangles */
+	void QHull(TArray<FVector2D> Cloud, int32 Iterations, bool Legalize = false);
+
+	template<typename AllocatorType>
+	void QHull(TArray<FVector2D> Cloud, int32 Iterations, bool Legalize, TTriangulationScratch<AllocatorType>& Scratch);
+
+	/** Delaunay triangulates vertical stripes of the point cloud concurrently and merges them. Yields the same triangulation as QHull, ties are broken symbolically,
+	 * but triangles come in a different order and start at a different vertex. Stripes only depend on the number of points so the order is deterministic */
+	void QHullParallel(TArray<FVector2D> Cloud, int32 StripeSize = 8192);
+
+	/** Forces an edge between two vertices into the triangulation, splits at vertices on the segment. Fails if it crosses another constraint */
+	bool AddConstraint(int32 From, int32 To);
+	bool IsConstrained(int32 From, int32 To) const;
+
+	/** Constrains a closed vertex loop and removes all triangles inside of it. On failure the constraints added for the loop are rolled back,
+	 * edges flipped while inserting them stay flipped */
+	bool AddHole(const TArray<int32>& Loop, ETriangulationHoleError* OutError = nullptr);
+
+	/** Delaunay refinement: inserts the circumcenters of triangles with an angle below MinAngle degrees, clamped to 30, or an edge longer than MaxEdgeLength at their centroid, worst first.
+	 * Border and constrained edges a circumcenter would encroach on are split at their midpoint instead. Stops at MaxTriangles, returns whether all triangles meet quality */
+	bool Refine(double MinAngle, TFunctionRef<double(const FVector2D&)> MaxEdgeLength, int32 MaxTriangles);
+
+	/** Removes a vertex and Delaunay triangulates the hole it leaves, freed triangle slots are reused by later inserts.
+	 * Fails and leaves the triangulation untouched for vertices on a constraint or links too degenerate to clip */
+	bool RemovePoint(int32 Vertex);
+
+	/** Moves vertices and flips edges around them, vertices that leave their star or lie on the hull are removed and inserted again under the same index.
+	 * Without constraints targets outside the hull extend it, or rebuild from the connected vertices if that fails. Removed and unconnected vertices stay out of the rebuild.
+	 * With constraints or disabled triangles there is no rebuild, targets that can't be inserted leave their vertex unconnected.
+	 * Fails if a constrained vertex has to leave its star, a vertex is left unconnected or a target lands on another vertex, which also leaves it unconnected */
+	bool MovePoints(TArrayView<const int32> Vertices, TArrayView<const FVector2D> Targets);
+
+	/** Moves vertices to the same index in Targets */
+	bool MovePoints(TArrayView<const FVector2D> Targets);
+
+	/** Drops free and disabled triangles and vertices no triangle uses, remapping all indices */
+	void Compact();
+
+	/** Empties points, triangles, constraints and free slots and drops the caches, keeps the allocations */
+	void Reset();
+
+	/** Checks vertex indices, clockwise winding, symmetric adjacency and optionally the empty circumcircle property of unconstrained edges.
+	 * Logs the first violation as a warning */
+	bool Validate(bool Delaunay = true) const;
+
+	/** Versioned binary layout including constraints and free slots, caches are rebuilt on demand after loading.
+	 * Packages saved before it exists fall back to tagged properties. Out of range indices set an archive error and leave the triangulation empty */
+	bool Serialize(FArchive& Ar);
+
+	/** Voronoi dual over enabled triangles, rebuilt on first access after the triangulation changed.
+	 * The rebuild writes the cache despite being const, so concurrent readers have to call UpdateVoronoi on one thread first */
+	const FGenVoronoi& GetVoronoi() const;
+
+	/** Rebuilds the dual if it is stale, afterwards GetVoronoi and GetVoronoiCell only read until the triangulation changes again */
+	const FGenVoronoi& UpdateVoronoi();
+
+	/** Clockwise cell polygon of a vertex, border cells include the midpoints of their border edges and the vertex */
+	void GetVoronoiCell(int32 Vertex, TArray<FVector2D>& Polygon) const;
+
+	/** Member functions invalidate the dual themselves, only needed after editing Points or Triangles directly */
+	FORCEINLINE void InvalidateVoronoi() { VoronoiValid = false; }
+
+	/** Constrained edges as vertex pairs, never flipped */
+	TSet<uint64> Constraints;
+
+private:
+	void BuildBuckets() const;
+	int32 GetBucket(const FVector2D& Point) const;
+
+	bool MergeHulls(int32 Left, int32 Right, TArray<int32>& HullTri, TArray<int32>& HullNext, TArray<int32>& HullPrev);
+
+	/** Triangles around a vertex in walking order, starts from Hint if it contains the vertex */
+	void GetVertexFan(int32 Vertex, TArray<int32>& Fan, int32 Hint = INDEX_NONE) const;
+	void TriangulatePseudoPolygon(int32 From, int32 To, const TArray<int32>& Chain, TArray<FGenTriangle>& Out) const;
+	void CompactTriangles(const TBitArray<>& Removed);
+	int32 AllocateTriangle();
+
+	/** Connects a vertex that no triangle uses, returns the vertex at that location or INDEX_NONE if outside */
+	int32 InsertVertex(int32 PointIndex);
+
+	template<typename AllocatorType>
+	int32 InsertVertex(int32 PointIndex, TArray<FGenTriangleEdge, AllocatorType>& FlipStack);
+
+	/** Splits the edge opposite to Edge and the triangle across it at a vertex no triangle uses, constraints continue through it */
+	template<typename AllocatorType>
+	int32 SplitEdge(int32 TriangleIndex, int32 Edge, int32 PointIndex, TArray<FGenTriangleEdge, AllocatorType>& FlipStack);
+
+	/** Connects a vertex outside of a convex triangulation to all border edges it sees, returns INDEX_NONE if it sees none.
+	 * Walks the hull from a vertex on it, without one it searches the buffer for a border edge first */
+	int32 ExtendHull(int32 PointIndex, int32 HullVertex);
+
+	// Triangle slots released by RemovePoint, marked by INDEX_NONE vertices and disabled
+	TArray<int32> FreeTriangles;
+
+	// Point location cache, not serialized
+	mutable TArray<int32> Buckets;
+	mutable FBox2D BucketBounds = FBox2D(ForceInit);
+	mutable int32 BucketRes = 0;
+	mutable int32 BucketNum = 0;
+	mutable int32 LastTriangle = INDEX_NONE;
+
+	// Dual cache, not serialized
+	mutable FGenVoronoi Voronoi;
+	mutable bool VoronoiValid = false;
+};
+
+template<>
+struct TStructOpsTypeTraits<FTriangulation2D> : public TStructOpsTypeTraitsBase2<FTriangulation2D>
+{
+	enum { WithSerializer = true };
 };
 
 USTRUCT(BlueprintType)
@@ -117,6 +398,8 @@ struct ANGRYPROCEDURALTOOLS_API FGenTriangleVertex
 
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Procedural Mesh")
 		FColor Color;
+
+	friend ANGRYPROCEDURALTOOLS_API FArchive& operator<<(FArchive& Ar, FGenTriangleVertex& Vertex);
 };
 
 USTRUCT(BlueprintType)
@@ -128,6 +411,8 @@ struct ANGRYPROCEDURALTOOLS_API FGenConvexMesh
 
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Procedural Mesh")
 		TArray<FVector> Points;
+
+	friend ANGRYPROCEDURALTOOLS_API FArchive& operator<<(FArchive& Ar, FGenConvexMesh& Mesh);
 };
 
 USTRUCT(BlueprintType)
@@ -147,5 +432,14 @@ struct ANGRYPROCEDURALTOOLS_API FGenTriangleMesh
 
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Procedural Mesh")
 		UMaterialInterface* Material;
+
+	/** Versioned binary layout of the triangulation followed by the reflected members, older packages fall back to tagged properties */
+	bool Serialize(FArchive& Ar);
+};
+
+template<>
+struct TStructOpsTypeTraits<FGenTriangleMesh> : public TStructOpsTypeTraitsBase2<FGenTriangleMesh>
+{
+	enum { WithSerializer = true };
 };
 